@@ -0,0 +1,208 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_benchmark: Measures the parser and the player with Google Benchmark.
+// Each benchmark plays the whole corpus with begin() and play() on a virtual clock.
+// The parsing mode is selected at compile time. The strict and relaxed
+// executables are built from this file. See CMakeLists.txt.
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+#include "anyrtttl.h"
+#include "binrtttl.h"
+
+static const byte BENCHMARK_PIN = 8; // any pin. No buzzer is connected.
+
+// The melodies of the corpus in all formats.
+struct corpus_t
+{
+  std::vector<std::string> text;
+  std::vector< std::vector<unsigned char> > binary10;
+  std::vector< std::vector<unsigned char> > binary16;
+  size_t textBytes;
+  size_t binary10Bytes;
+  size_t binary16Bytes;
+  size_t notes;
+};
+static corpus_t gCorpus;
+
+// The virtual clock moves forward by 1 minute each time it is read.
+// Every call to play() starts the next note.
+static unsigned long gVirtualMillis = 0;
+
+static unsigned long virtualMillis()
+{
+  gVirtualMillis += 60000;
+  return gVirtualMillis;
+}
+
+static void silentTone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+}
+
+static void silentNoTone(uint8_t pin)
+{
+}
+
+static std::string trim(const std::string & iValue)
+{
+  static const char * WHITESPACES = " \t\r\n";
+  size_t first = iValue.find_first_not_of(WHITESPACES);
+  if (first == std::string::npos)
+    return "";
+  size_t last = iValue.find_last_not_of(WHITESPACES);
+  return iValue.substr(first, last - first + 1);
+}
+
+// Adds the RTTTL melodies found in a text file to the corpus.
+// Lines that are not valid melodies are ignored.
+static bool loadCorpus(const char * iPath)
+{
+  std::ifstream file(iPath);
+  if (!file.is_open())
+  {
+    fprintf(stderr, "Unable to open corpus file '%s'.\n", iPath);
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    line = trim(line);
+    size_t first = line.find(':');
+    if (first == std::string::npos || line.find(':', first+1) == std::string::npos)
+      continue;
+    uint16_t notes = anyrtttl::compile(line.c_str(), NULL, 0);
+    if (notes == 0)
+      continue;
+
+    std::vector<unsigned char> binary10(anyrtttl::encode10(line.c_str(), NULL, 0));
+    std::vector<unsigned char> binary16(anyrtttl::encode16(line.c_str(), NULL, 0));
+    if (binary10.empty() || binary16.empty())
+      continue; // not representable as binary RTTTL
+    anyrtttl::encode10(line.c_str(), &binary10[0], (uint16_t)binary10.size());
+    anyrtttl::encode16(line.c_str(), &binary16[0], (uint16_t)binary16.size());
+
+    gCorpus.text.push_back(line);
+    gCorpus.binary10.push_back(binary10);
+    gCorpus.binary16.push_back(binary16);
+    gCorpus.textBytes += line.size();
+    gCorpus.binary10Bytes += binary10.size();
+    gCorpus.binary16Bytes += binary16.size();
+    gCorpus.notes += notes;
+  }
+  return true;
+}
+
+static void setCounters(benchmark::State & state, size_t iBytes)
+{
+  state.SetBytesProcessed((int64_t)(state.iterations() * iBytes));
+  state.counters["notes"] = benchmark::Counter((double)gCorpus.notes);
+  state.counters["per_note"] = benchmark::Counter((double)gCorpus.notes, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+template<typename Player>
+static void BM_Text(benchmark::State & state)
+{
+  Player player;
+  for (auto _ : state)
+  {
+    for(size_t i=0; i<gCorpus.text.size(); i++)
+    {
+      player.begin(BENCHMARK_PIN, gCorpus.text[i].c_str());
+      while (!player.done())
+        player.play();
+    }
+    benchmark::DoNotOptimize(player.context.noteIndex);
+  }
+  setCounters(state, gCorpus.textBytes);
+}
+BENCHMARK_TEMPLATE(BM_Text, anyrtttl::ram_player);
+BENCHMARK_TEMPLATE(BM_Text, anyrtttl::progmem_player);
+BENCHMARK_TEMPLATE(BM_Text, anyrtttl::progmem_buffered_player);
+
+static void BM_Binary10(benchmark::State & state)
+{
+  anyrtttl::rtttl_context_t c = {0};
+  for (auto _ : state)
+  {
+    for(size_t i=0; i<gCorpus.binary10.size(); i++)
+    {
+      const std::vector<unsigned char> & melody = gCorpus.binary10[i];
+      anyrtttl::nonblocking::beginBinary10(c, BENCHMARK_PIN, &melody[0], (uint16_t)melody.size());
+      while (!anyrtttl::nonblocking::done(c))
+        anyrtttl::nonblocking::play(c);
+    }
+    benchmark::DoNotOptimize(c.noteIndex);
+  }
+  setCounters(state, gCorpus.binary10Bytes);
+}
+BENCHMARK(BM_Binary10);
+
+static void BM_Binary16(benchmark::State & state)
+{
+  anyrtttl::rtttl_context_t c = {0};
+  for (auto _ : state)
+  {
+    for(size_t i=0; i<gCorpus.binary16.size(); i++)
+    {
+      const std::vector<unsigned char> & melody = gCorpus.binary16[i];
+      anyrtttl::nonblocking::beginBinary16(c, BENCHMARK_PIN, &melody[0], (uint16_t)melody.size());
+      while (!anyrtttl::nonblocking::done(c))
+        anyrtttl::nonblocking::play(c);
+    }
+    benchmark::DoNotOptimize(c.noteIndex);
+  }
+  setCounters(state, gCorpus.binary16Bytes);
+}
+BENCHMARK(BM_Binary16);
+
+int main(int argc, char * argv[])
+{
+  benchmark::Initialize(&argc, argv);
+
+  // Remaining arguments are corpus files
+  std::vector<const char *> paths;
+  for(int i=1; i<argc; i++)
+    paths.push_back(argv[i]);
+  if (paths.empty())
+  {
+    paths.push_back(ANYRTTTL_BENCHMARK_NOKIA_CORPUS);
+    paths.push_back(ANYRTTTL_BENCHMARK_MELODIES_CORPUS);
+  }
+  for(size_t i=0; i<paths.size(); i++)
+  {
+    if (!loadCorpus(paths[i]))
+      return 1;
+  }
+  if (gCorpus.notes == 0)
+  {
+    fprintf(stderr, "The corpus does not contain any melody.\n");
+    return 1;
+  }
+
+  anyrtttl::setToneFunction(&silentTone);
+  anyrtttl::setNoToneFunction(&silentNoTone);
+  anyrtttl::setMillisFunction(&virtualMillis);
+
+#if defined(RTTTL_PARSER_STRICT)
+  benchmark::AddCustomContext("parser", "RTTTL_PARSER_STRICT");
+#else
+  benchmark::AddCustomContext("parser", "RTTTL_PARSER_RELAXED");
+#endif
+  benchmark::AddCustomContext("corpus", std::to_string(gCorpus.text.size()) + " melodies, " + std::to_string(gCorpus.notes) + " notes");
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
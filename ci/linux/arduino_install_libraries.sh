@@ -23,8 +23,7 @@ echo ===========================================================================
 echo Installing arduino library dependencies
 echo ==========================================================================================================
 
-echo BitReader...
-arduino-cli lib install BitReader
+echo AnyRtttl has no library dependencies.
 echo
 
 cd "$(dirname "$0")"
@@ -25,9 +25,7 @@ echo ===========================================================================
 echo Installing arduino library dependencies
 echo ==========================================================================================================
 
-echo BitReader
-arduino-cli lib install BitReader
-if %errorlevel% neq 0 exit /b %errorlevel%
+echo AnyRtttl has no library dependencies.
 echo.
 
 cd /d "%~dp0"
@@ -0,0 +1,67 @@
+#include <anyrtttl.h>
+#include <pitches.h>
+
+// Plays melodies of a catalog stored in PROGMEM.
+// The catalog in beeps_catalog.h was generated with the anyrtttl_catalog tool:
+//   anyrtttl_catalog --format binary10 --name beeps_catalog --output beeps_catalog.h --file beeps.txt
+// Melodies are found by name or by id with a binary search in the catalog.
+// The sketch does not need a symbol or a string per melody.
+
+#include "beeps_catalog.h"
+
+// Define the BUZZER_PIN for current board
+#if defined(ESP32)
+#define BUZZER_PIN 25 // Using GPIO25 (pin labeled D25)
+#elif defined(ESP8266)
+#define BUZZER_PIN  2 // Using GPIO2  (pin labeled D4)
+#else // base arduino models
+#define BUZZER_PIN 9
+#endif
+
+//project's constants
+const char * names[] = { "bootUp", "ready01", "connect", "notification01", "success01", "fail01", "error01", "powerDown" };
+const uint8_t namesCount = sizeof(names)/sizeof(names[0]);
+uint8_t nameIndex = 0; //which melody to play when the previous one finishes
+anyrtttl::rtttl_context_t context = {0};
+
+void setup() {
+  pinMode(BUZZER_PIN, OUTPUT);
+
+  Serial.begin(115200);
+  Serial.println();
+  Serial.print("Catalog has ");
+  Serial.print(anyrtttl::catalog::getCount_P(beeps_catalog));
+  Serial.println(" melodies.");
+}
+
+void loop() {
+  // If we are not playing something
+  if ( !anyrtttl::nonblocking::isPlaying(context) )
+  {
+    if (nameIndex >= namesCount)
+    {
+      // play the first melody of the catalog by id, then start over
+      anyrtttl::rtttl_catalog_melody_t melody;
+      if (anyrtttl::catalog::getById_P(beeps_catalog, BEEPS_CATALOG_BOOTUP, melody))
+        anyrtttl::blocking::playBinary10_P(BUZZER_PIN, melody.buffer, melody.size);
+      nameIndex = 0;
+      delay(3000);
+      return;
+    }
+
+    // find the next melody by name
+    anyrtttl::rtttl_catalog_melody_t melody;
+    if (anyrtttl::catalog::findByName_P(beeps_catalog, names[nameIndex], melody))
+    {
+      Serial.print("Playing ");
+      Serial.println(names[nameIndex]);
+      anyrtttl::catalog::begin_P(context, BUZZER_PIN, melody);
+    }
+    nameIndex++;
+    delay(500);
+  }
+  else
+  {
+    anyrtttl::nonblocking::play(context);
+  }
+}
@@ -0,0 +1,26 @@
+// RTTTL catalog generated by anyrtttl_catalog.
+// 8 melodies, 169 bytes.
+
+// Melody ids. Use with anyrtttl::catalog::getById().
+static const uint16_t BEEPS_CATALOG_FAIL01 = 0; // fail01
+static const uint16_t BEEPS_CATALOG_BOOTUP = 1; // bootUp
+static const uint16_t BEEPS_CATALOG_NOTIFICATION01 = 2; // notification01
+static const uint16_t BEEPS_CATALOG_ERROR01 = 3; // error01
+static const uint16_t BEEPS_CATALOG_CONNECT = 4; // connect
+static const uint16_t BEEPS_CATALOG_POWERDOWN = 5; // powerDown
+static const uint16_t BEEPS_CATALOG_READY01 = 6; // ready01
+static const uint16_t BEEPS_CATALOG_SUCCESS01 = 7; // success01
+
+const unsigned char beeps_catalog[] PROGMEM = {
+  0x52, 0x54, 0x43, 0x31, 0x08, 0x00, 0x00, 0x00, 0x62, 0xBC, 0x7E, 0x0A, 0x68, 0x00, 0x00, 0x00,
+  0x06, 0x00, 0x02, 0x00, 0xD0, 0xED, 0xED, 0x14, 0x6E, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x02, 0x00,
+  0x89, 0x69, 0x1D, 0x52, 0x79, 0x00, 0x00, 0x00, 0x09, 0x00, 0x02, 0x00, 0xA6, 0x73, 0xF6, 0x62,
+  0x82, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0xF9, 0xCC, 0xE0, 0xAA, 0x88, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x02, 0x00, 0x8E, 0x2E, 0xFE, 0xAC, 0x91, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x02, 0x00,
+  0x87, 0xC5, 0x72, 0xAE, 0x9C, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x83, 0x8C, 0x9A, 0xC1,
+  0xA2, 0x00, 0x00, 0x00, 0x07, 0x00, 0x02, 0x00, 0x0B, 0x1E, 0x1B, 0x2D, 0x34, 0x10, 0x4C, 0x15,
+  0x04, 0x51, 0x44, 0x12, 0x81, 0x14, 0x92, 0x28, 0x30, 0x94, 0x16, 0x14, 0x92, 0xC8, 0x22, 0x8D,
+  0x22, 0x02, 0x0B, 0x1E, 0x03, 0xAD, 0xB4, 0x11, 0x0C, 0x14, 0x1C, 0xB1, 0x44, 0x20, 0x85, 0x22,
+  0x02, 0x4C, 0x15, 0x04, 0x93, 0x48, 0x21, 0x81, 0x24, 0x51, 0x24, 0x10, 0x13, 0x1E, 0x03, 0x4E,
+  0x38, 0x30, 0xD3, 0x12, 0x03, 0x4E, 0x38, 0xA2, 0xC0
+};
@@ -0,0 +1,71 @@
+#include <anyrtttl.h>
+#include <pitches.h>
+
+// Measures the time spent parsing RTTTL melodies and prints the number of CPU cycles per note.
+// Melodies are only parsed with anyrtttl::compile(). No sound is played.
+// Define RTTTL_PARSER_STRICT or RTTTL_PARSER_RELAXED as global macros for comparing both parsing modes.
+// See GlobalMacros.md for instructions.
+
+//project's constants
+#define BENCHMARK_ITERATIONS 100
+
+const char tetris[] PROGMEM = "tetris:d=4,o=5,b=160:e6,8b,8c6,8d6,16e6,16d6,8c6,8b,a,8a,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,2a,8p,d6,8f6,a6,8g6,8f6,e6,8e6,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,a";
+const char simpsons[] PROGMEM = "The Simpsons:d=4,o=5,b=160:c.6,e6,f#6,8a6,g.6,e6,c6,8a,8f#,8f#,8f#,2g,8p,8p,8f#,8f#,8f#,8g,a#.,8c6,8c6,8c6,c6";
+const char indiana[] PROGMEM = "Indiana:d=4,o=5,b=250:e,8p,8f,8g,8p,1c6,8p.,d,8p,8e,1f,p.,g,8p,8a,8b,8p,1f6,p,a,8p,8b,2c6,2d6,2e6,e,8p,8f,8g,8p,1c6,p,d6,8p,8e6,1f.6,g,8p,8g,e.6,8p,d6,8p,8g,e.6,8p,d6,8p,8g,f.6,8p,e6,8p,8d6,2c6";
+
+const char * const melodies[] = { tetris, simpsons, indiana };
+const uint8_t melodiesCount = sizeof(melodies)/sizeof(melodies[0]);
+
+char buffer[256];
+
+void benchmark(const char * iName, const char * iMelody) {
+  unsigned long notes = 0;
+  unsigned long start = micros();
+  for(int i=0; i<BENCHMARK_ITERATIONS; i++) {
+    notes += anyrtttl::compile(iMelody, NULL, 0);
+  }
+  unsigned long elapsed = micros() - start;
+
+  unsigned long cyclesPerNote = 0;
+  if (notes > 0)
+    cyclesPerNote = (unsigned long)(((unsigned long long)elapsed * (F_CPU / 1000000UL)) / notes);
+
+  Serial.print(iName);
+  Serial.print(": ");
+  Serial.print(notes / BENCHMARK_ITERATIONS);
+  Serial.print(" notes, ");
+  Serial.print(elapsed);
+  Serial.print(" us, ");
+  Serial.print(cyclesPerNote);
+  Serial.println(" cycles per note");
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ready");
+
+#if defined(RTTTL_PARSER_STRICT)
+  Serial.println("Parser: RTTTL_PARSER_STRICT");
+#else
+  Serial.println("Parser: RTTTL_PARSER_RELAXED");
+#endif
+}
+
+void loop() {
+  for(uint8_t i=0; i<melodiesCount; i++) {
+    // copy the melody to RAM to measure the parser instead of the flash memory reads
+    strncpy_P(buffer, melodies[i], sizeof(buffer)-1);
+    buffer[sizeof(buffer)-1] = '\0';
+
+    char name[16] = {0};
+    strncpy(name, buffer, sizeof(name)-1);
+    char * separator = strchr(name, ':');
+    if (separator)
+      *separator = '\0';
+
+    benchmark(name, buffer);
+  }
+  Serial.println();
+
+  delay(5000);
+}
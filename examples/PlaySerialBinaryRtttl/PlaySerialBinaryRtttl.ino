@@ -0,0 +1,97 @@
+#include <anyrtttl.h>
+#include <binrtttl.h>
+#include <pitches.h>
+
+/*
+This example shows how AnyRtttl can play binary RTTTL melodies that are received from the serial bus
+with the wire protocol (see anyrtttl::wire). Each note is sent with 10 or 16 bits instead of about 3.3 characters.
+Frames are protected with a CRC. A corrupted frame is dropped and the rest of the melody is played.
+To use this example, connect to the board's serial port at 115200 baud and send frames with the anyrtttl_wire tool:
+
+  anyrtttl_wire --device /dev/ttyUSB0 "tetris:d=4,o=5,b=160:e6,8b,8c6,8d6,16e6,16d6,8c6,8b,a,8a,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,2a,8p,d6,8f6,a6,8g6,8f6,e6,8e6,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,a"
+
+Playback starts with the first frame of notes while the rest of the melody is still being received
+and the loop() function never waits for the serial port.
+*/
+
+// Define the BUZZER_PIN for current board
+#if defined(ESP32)
+#define BUZZER_PIN 25 // Using GPIO25 (pin labeled D25)
+#elif defined(ESP8266)
+#define BUZZER_PIN  2 // Using GPIO2  (pin labeled D4)
+#else // base arduino models
+#define BUZZER_PIN 9
+#endif
+
+// project's variables
+anyrtttl::rtttl_wire_t melody_wire;       // The decoder of the frames received from the serial port.
+anyrtttl::rtttl_stream_t melody_stream;   // The notes decoded from the frames.
+anyrtttl::rtttl_context_t context = {0};  // The state of the melody being played.
+
+// Function receiveSerialBytes() feeds the bytes available on the serial port to the decoder.
+// The function never waits for a byte. Notes are played as soon as they are received.
+// A byte is only removed from the serial port when the decoder accepts it.
+// The decoder does not accept a byte if the queue of notes is full.
+void receiveSerialBytes() {
+  // add the pending notes of the last frame to the queue
+  anyrtttl::wire::feed(melody_wire, NULL, 0);
+
+  while (Serial.available() > 0 && !anyrtttl::stream::isEnded(melody_stream)) {
+    if (!anyrtttl::wire::feed(melody_wire, (unsigned char)Serial.peek()))
+      return; // the queue is full. Try again after the next note is played.
+    Serial.read();
+  }
+}
+
+#ifdef ESP32
+// Function esp32GetChannelForPin() maps a channel for a given pin.
+// Returns a value between 0 and n where n is the maximum of channel for your board.
+// Returns ESP32_INVALID_CHANNEL if there is no assigned channel for the given pin number.
+// See your board documentation for details.
+// See https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/peripherals/ledc.html#led-control-ledc
+uint8_t getChannelForPin(uint8_t pin) {
+  if (pin == BUZZER_PIN) return 0; // using channel 0 for pin BUZZER_PIN
+  return 0xFF; // invalid
+}
+#endif // ESP32
+
+void setup() {
+  // silence BUZZER_PIN asap
+  pinMode(BUZZER_PIN, OUTPUT);
+  digitalWrite(BUZZER_PIN, LOW);
+
+  Serial.begin(115200);
+  Serial.println("ready");
+
+#ifdef ESP32
+  // setup AnyRtttl for ESP32
+  esp32::setChannelMapFunction(&getChannelForPin);  // Required for functions using esp32 core version 2.x.
+  anyrtttl::setToneFunction(&esp32::tone);          // tell AnyRtttl to use AnyRtttl's specialized esp32 tone function.
+  anyrtttl::setNoToneFunction(&esp32::noTone);      // tell AnyRtttl to use AnyRtttl's specialized esp32 noTone() function.
+
+  // setup the pin for PWM tones.
+  esp32::toneSetup(BUZZER_PIN);
+#endif // ESP32
+
+}
+
+void loop() {
+  if ( anyrtttl::nonblocking::done(context) )
+  {
+    // We are done playing the previous melody or
+    // it is the first time we enter the loop() function.
+
+    if (melody_wire.errors > 0) {
+      Serial.print("errors: ");
+      Serial.println(melody_wire.errors);
+    }
+
+    // Start playing a new one. Notes are played as they are received.
+    anyrtttl::wire::init(melody_wire, melody_stream);
+    anyrtttl::nonblocking::beginStream(context, BUZZER_PIN, melody_stream);
+  }
+
+  // receive the next bytes and play the next note when required
+  receiveSerialBytes();
+  anyrtttl::nonblocking::play(context);
+}
@@ -5,8 +5,10 @@
 /*
 This example shows how AnyRtttl can be adapted to play an RTTTL melody that is received from the serial bus.
 To use this example, connect to the board's serial port at 115200 baud and send the melody.
-A newline character at the end is mandatory. A newline character triggers the end of the melody
-and will stop the library from playing.
+The melody is parsed with a push parser (see anyrtttl::stream) as characters are received.
+Playback starts with the first notes while the rest of the melody is still being received
+and the loop() function never waits for the serial port.
+A newline character at the end is mandatory. A newline character triggers the end of the melody.
 
 Copy one of the following in the clipboard and paste it in the serial monitor:
 
@@ -15,8 +17,6 @@ Arkanoid:d=4,o=5,b=140:8g6,16p,16g.6,2a#6,32p,8a6,8g6,8f6,8a6,2g6
 mario:d=4,o=5,b=140:16e6,16e6,32p,8e6,16c6,8e6,8g6,8p,8g,8p,8c6,16p,8g,16p,8e,16p,8a,8b,16a#,8a,16g.,16e6,16g6,8a6,16f6,8g6,8e6,16c6,16d6,8b,16p,8c6,16p,8g,16p,8e,16p,8a,8b,16a#,8a,16g.,16e6,16g6,8a6,16f6,8g6,8e6,16c6,16d6,8b,8p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16g#,16a,16c6,16p,16a,16c6,16d6,8p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16c7,16p,16c7,16c7,p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16g#,16a,16c6,16p,16a,16c6,16d6,8p,16d#6,8p,16d6,8p,16c6
 */
 
-#define SKETCH_NON_BLOCKING_MODE 1
-
 // Define the BUZZER_PIN for current board
 #if defined(ESP32)
 #define BUZZER_PIN 25 // Using GPIO25 (pin labeled D25)
@@ -26,50 +26,35 @@ mario:d=4,o=5,b=140:16e6,16e6,32p,8e6,16c6,8e6,8g6,8p,8g,8p,8c6,16p,8g,16p,8e,16
 #define BUZZER_PIN 9
 #endif
 
-// project's constants
-const char * fake_melody_address;     // The address of a fictionnal buffer containing the melody.
-const char * previous_read_address;   // The address of the previous character read from melody.
-char previous_read_character;         // The previous character read from the serial port.
-
-// Function readSerialChar() read 1 character for the serial port.
-// The function is blocking until a character is read from the serial port.
-// The readed character is returned by the function.
-char readSerialChar() {
-  // Wait until a character is available
-  while (Serial.available() == 0) {
-    delay(1); // prevent watchdog from reseting some boards.
+// project's variables
+anyrtttl::rtttl_stream_t melody_stream;   // The parser of the melody received from the serial port.
+anyrtttl::rtttl_context_t context = {0};  // The state of the melody being played.
+bool end_pending = false;                 // The end of the melody was received but the last note was not queued yet.
+
+// Function receiveSerialChars() feeds the characters available on the serial port to the parser.
+// The function never waits for a character. Notes are played as soon as they are received.
+// A character is only removed from the serial port when the parser accepts it.
+// The parser does not accept a character if its queue of notes is full.
+void receiveSerialChars() {
+  if (end_pending) {
+    end_pending = !anyrtttl::stream::end(melody_stream);
+    return;
   }
 
-  // Read and return the character
-  char c = Serial.read();
-  return c;
-}
-
-// Function anyrtttlGetCharAdaptorFunc() read the first character from a "fictionnal melody buffer".
-// For this sketch, iBuffer is an invalid buffer address.
-// The function checks iBuffer and compares it with the previous address
-// to know how many characters to actually read from the serial port.
-// The function is blocking until the required number of characters is read from the serial port.
-// The last character read is returned by the function.
-char anyrtttlGetCharAdaptorFunc(const char * iBuffer) {
-  // Define how man characters to read
-  size_t count = (size_t)(iBuffer - previous_read_address);
-
-  // Read that many character
-  for(size_t i=0; i < count; i++) {
-    previous_read_character = readSerialChar();
-  }
+  while (Serial.available() > 0 && !anyrtttl::stream::isEnded(melody_stream)) {
+    char c = (char)Serial.peek();
 
-  // Update the previous address read
-  previous_read_address += count;
-
-  // Convert newline characters as a NULL character to simulate the end of the RTTTL melody.
-  // This triggers the melody playback code to stop.
-  if (previous_read_character == '\r' || previous_read_character == '\n')
-    previous_read_character = '\0';
+    // A newline character is the end of the melody.
+    if (c == '\r' || c == '\n') {
+      Serial.read();
+      end_pending = !anyrtttl::stream::end(melody_stream);
+      return;
+    }
 
-  // Return the last character read
-  return previous_read_character;
+    if (!anyrtttl::stream::feed(melody_stream, c))
+      return; // the queue is full. Try again after the next note is played.
+    Serial.read();
+  }
 }
 
 #ifdef ESP32
@@ -104,41 +89,23 @@ void setup() {
 
 }
 
-void preparePlayingNextMelody() {
-  // Sketch variables initialisation for next melody
-  previous_read_address = (const char*)0x0000;
-  fake_melody_address = (const char*)0x0001; // Initialized to 1 charaacter after `previous_read_address` to force reading 1 character on the first call to anyrtttlGetCharAdaptorFunc().
-  previous_read_character = '\0';
-}
-
 void loop() {
-  #ifdef SKETCH_NON_BLOCKING_MODE
-    // Non-blocking example
-
-    if ( anyrtttl::nonblocking::done() ) 
-    {
-      // We are done playing the previous melody or
-      // it is the first time we enter the loop() function.
-      
-      // Prepare for playing the next melody
-      preparePlayingNextMelody();
-      
-      // Start playing a new one
-      anyrtttl::nonblocking::begin(BUZZER_PIN, fake_melody_address, &anyrtttlGetCharAdaptorFunc);
-    }
-    else {
-      // continue playing
-      anyrtttl::nonblocking::play();
-    }
-  #else
-    // Blocking example
-
-    // Prepare for playing the next melody
-    preparePlayingNextMelody();
-
-    // Start playing
-    anyrtttl::blocking::play(BUZZER_PIN, fake_melody_address, &anyrtttlGetCharAdaptorFunc);
+  if ( anyrtttl::nonblocking::done(context) ) 
+  {
+    // We are done playing the previous melody or
+    // it is the first time we enter the loop() function.
+
+    // Skip the newline characters following the previous melody
+    while (Serial.available() > 0 && (Serial.peek() == '\r' || Serial.peek() == '\n'))
+      Serial.read();
+
+    // Start playing a new one. Notes are played as they are received.
+    anyrtttl::stream::init(melody_stream);
+    anyrtttl::nonblocking::beginStream(context, BUZZER_PIN, melody_stream);
+    end_pending = false;
+  }
 
-    delay(1000);
-  #endif // SKETCH_NON_BLOCKING_MODE
+  // receive the next characters and play the next note when required
+  receiveSerialChars();
+  anyrtttl::nonblocking::play(context);
 }
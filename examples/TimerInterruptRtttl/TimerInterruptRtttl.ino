@@ -0,0 +1,54 @@
+#include <anyrtttl.h>
+#include <pitches.h>
+
+// Plays a melody from the Timer1 interrupt of an ATmega328 (Arduino Uno, Nano).
+// The loop() function is free to run long operations without delaying the notes.
+
+//project's constants
+#define BUZZER_PIN 9
+const char * tetris = "tetris:d=4,o=5,b=160:e6,8b,8c6,8d6,16e6,16d6,8c6,8b,a,8a,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,2a,8p,d6,8f6,a6,8g6,8f6,e6,8e6,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,a";
+
+anyrtttl::rtttl_context_t context = {0};
+
+// Timer1 interrupt
+ISR(TIMER1_COMPA_vect) {
+  anyrtttl::timer::tick();
+}
+
+// Starts Timer1 in CTC mode with the given period.
+void timer1Start(unsigned long iPeriodUs, anyrtttl::TimerCallbackFuncPtr iCallback) {
+  // The ISR calls anyrtttl::timer::tick() directly. iCallback is not required.
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);      // CTC mode, prescaler 64
+  TCNT1 = 0;
+  OCR1A = (uint16_t)((F_CPU / 64 / 1000) * iPeriodUs / 1000 - 1);
+  TIMSK1 |= (1 << OCIE1A);                                // enable compare interrupt
+  interrupts();
+}
+
+// Stops Timer1. Called from the interrupt at the end of the melody.
+void timer1Stop() {
+  TIMSK1 &= ~(1 << OCIE1A);
+}
+
+void setup() {
+  pinMode(BUZZER_PIN, OUTPUT);
+
+  Serial.begin(115200);
+  Serial.println("ready");
+
+  anyrtttl::timer::setTimerFunctions(&timer1Start, &timer1Stop);
+}
+
+void loop() {
+  if ( anyrtttl::timer::done() )
+  {
+    // Start playing a new melody from the timer
+    anyrtttl::timer::begin(context, BUZZER_PIN, tetris);
+  }
+
+  // Simulate a long operation. The melody is not affected.
+  Serial.println("busy...");
+  delay(50);
+}
@@ -138,7 +138,7 @@ void runTest(const char* testName, TestFunc func)
   do { \
     if ((expected) == (actual)) { \
       testTracesAppend("ASSERT_NE failed: expected==actual==%d (file %s, line %d)", \
-                        (int)(val1), __FILE__, __LINE__); \
+                        (int)(expected), __FILE__, __LINE__); \
       return TestResult::Fail; \
     }\
   } while (0)
@@ -1,6 +1,8 @@
 #define RTTTL_PARSER_RELAXED
 
 #include <anyrtttl.h>
+#include <binrtttl.h>
+#include <rtttl_melody.h>
 #include <pitches.h>
 #include <stdint.h>
 #include <sstream>
@@ -8,6 +10,12 @@
 #include "LoggingFramework.hpp"
 #include "StringFormatter.hpp"
 
+#if defined(__linux__)
+#include <thread>
+#include <atomic>
+#include <chrono>
+#endif
+
 // Define the BUZZER_PIN for current board
 #define BUZZER_PIN 0 // Using a fake pin number
 
@@ -83,6 +91,20 @@ size_t countTokens(const char * token, const char * str) {
   return count;
 }
 
+// Remove the timestamps (if any) from all lines of the given melody output.
+std::string removeTimestamps(const std::string & str) {
+  std::istringstream iss(str);
+  std::string output;
+  std::string line;
+  while (std::getline(iss, line)) {
+    size_t pos = line.find(": ");
+    if (pos != std::string::npos)
+      line = line.substr(pos + 2);
+    output += line + "\n";
+  }
+  return output;
+}
+
 unsigned long getToneTimestamp(const char * token, const std::string & str) {
     std::istringstream iss(str);
     std::string line;
@@ -1389,6 +1411,1279 @@ TestResult testStop() {
   return TestResult::Pass;
 }
 
+TestResult testCompiledMelody() {
+  static const size_t MELODY_BUFFER_SIZE = 256;
+  char melody[MELODY_BUFFER_SIZE] = {0};
+
+  sprintf(melody, simpsons);
+  testTracesAppend("melody=`%s`\n", melody);
+
+  // play the text melody as a reference
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, melody);
+  std::string expected = gMelodyOutput;
+
+  // compile the melody
+  static const uint16_t MAX_EVENTS = 32;
+  anyrtttl::rtttl_note_event_t events[MAX_EVENTS];
+  uint16_t count = anyrtttl::compile(melody, NULL, 0);
+  ASSERT_EQ(simpsons_expected_notes_count + 1, count); // +1 for the 32p pause
+  count = anyrtttl::compile(melody, events, MAX_EVENTS);
+  ASSERT_EQ(simpsons_expected_notes_count + 1, count);
+  ASSERT_EQ(NOTE_SILENT, events[0].frequency);
+  ASSERT_EQ(1047, events[1].frequency);
+  ASSERT_EQ(562, events[1].duration);
+
+  // play the compiled melody
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, events, count);
+  std::string actual = gMelodyOutput;
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+
+  // assert the compiled melody plays exactly like the text melody
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  return TestResult::Pass;
+}
+
+// A user-defined reader policy which reads a buffer in reverse order.
+struct reverse_reader {
+  const char * first; // address of the buffer
+  size_t length;      // length of the buffer
+  char read(const char * iBuffer) {
+    size_t offset = (size_t)(iBuffer - first);
+    return (offset < length ? first[length - 1 - offset] : '\0');
+  }
+};
+
+// A file of the file_source block source which counts the number of reads.
+struct fake_file {
+  const char * content;
+  size_t length;
+  size_t position;
+  int readCount;
+  bool seek(uint32_t pos) {
+    if (pos > length)
+      return false;
+    position = pos;
+    return true;
+  }
+  int read(uint8_t * buf, size_t size) {
+    readCount++;
+    size_t count = (length - position < size ? length - position : size);
+    memcpy(buf, content + position, count);
+    position += count;
+    return (int)count;
+  }
+};
+
+template<typename Player>
+std::string playWithPlayer(Player & player, const char * melody) {
+  resetTestData();
+  player.begin(BUZZER_PIN, melody);
+  while( !player.done() ) // Loop until the melody has played
+  {
+    player.play();
+    yield(); // prevent watchdog to reset the board.
+  }
+  return gMelodyOutput;
+}
+
+TestResult testPlayerReaderPolicies() {
+  static const size_t MELODY_BUFFER_SIZE = 256;
+  char melody[MELODY_BUFFER_SIZE] = {0};
+
+  sprintf(melody, simpsons);
+  testTracesAppend("melody=`%s`\n", melody);
+
+  // play the melody with the legacy api as a reference
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, melody);
+  std::string expected = gMelodyOutput;
+
+  // play with static reader policies
+  anyrtttl::ram_player ram_player;
+  std::string actual = playWithPlayer(ram_player, melody);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  anyrtttl::progmem_player progmem_player;
+  actual = playWithPlayer(progmem_player, melody);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // play with buffered readers
+  anyrtttl::progmem_buffered_player buffered_player;
+  actual = playWithPlayer(buffered_player, melody);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  fake_file file = { melody, strlen(melody), 0, 0 };
+  anyrtttl::file_source<fake_file> source = { &file };
+  anyrtttl::buffered_reader<anyrtttl::file_source<fake_file>, 16> file_reader(source);
+  anyrtttl::basic_player<anyrtttl::buffered_reader<anyrtttl::file_source<fake_file>, 16> > file_player(file_reader);
+  actual = playWithPlayer(file_player, (const char *)0); // the melody starts at offset 0 of the file
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+  ASSERT_EQ((int)(file.length / 16 + 1), file.readCount); // each block is read once
+
+  // a buffered reader never reads past the end of the melody.
+  // The melodies end at the edge of their allocation: build with -fsanitize=address to check any overflow.
+  size_t size = strlen(melody);
+  char * terminated = (char *)malloc(size + 1);
+  memcpy(terminated, melody, size + 1);
+  actual = playWithPlayer(buffered_player, terminated);
+  free(terminated);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  char * bounded = (char *)malloc(size); // no terminating '\0'
+  memcpy(bounded, melody, size);
+  resetTestData();
+  buffered_player.begin(BUZZER_PIN, bounded, (uint16_t)size);
+  while( !buffered_player.done() )
+  {
+    buffered_player.play();
+  }
+  free(bounded);
+  ASSERT_STRING_EQ(expected.c_str(), gMelodyOutput.c_str());
+
+  // play with a user-defined reader policy
+  char reversed[MELODY_BUFFER_SIZE] = {0};
+  size_t length = strlen(melody);
+  for(size_t i = 0; i < length; i++) {
+    reversed[i] = melody[length - 1 - i];
+  }
+  reverse_reader r;
+  r.first = reversed;
+  r.length = length;
+  anyrtttl::basic_player<reverse_reader> custom_player(r);
+  actual = playWithPlayer(custom_player, reversed);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  return TestResult::Pass;
+}
+
+// RTTTL 10 bits and 16 bits binary formats of the `tetris` melody.
+static const unsigned char tetris10[] = {0x0A, 0x14, 0x12, 0xCE, 0x34, 0xE0, 0x82, 0x14, 0x32, 0x38, 0xE0, 0x4C, 0x2A, 0xAD, 0x34, 0xA0, 0x84, 0x0B, 0x0E, 0x28, 0xD3, 0x4C, 0x03, 0x2A, 0x28, 0xA1, 0x80, 0x2A, 0xA5, 0xB4, 0x93, 0x82, 0x1B, 0xAA, 0x38, 0xE2, 0x86, 0x12, 0x4E, 0x38, 0xA0, 0x84, 0x0B, 0x0E, 0x28, 0xD3, 0x4C, 0x03, 0x2A, 0x28, 0xA1, 0x80, 0x2A, 0xA9, 0x04};
+static const unsigned char tetris16[] = {0x0A, 0x14, 0x12, 0x02, 0x33, 0x01, 0x03, 0x02, 0x0B, 0x02, 0x14, 0x02, 0x0C, 0x02, 0x03, 0x02, 0x33, 0x01, 0x2A, 0x01, 0x2B, 0x01, 0x03, 0x02, 0x12, 0x02, 0x0B, 0x02, 0x03, 0x02, 0x32, 0x01, 0x33, 0x01, 0x03, 0x02, 0x0A, 0x02, 0x12, 0x02, 0x02, 0x02, 0x2A, 0x01, 0x29, 0x01, 0x3B, 0x01, 0x0A, 0x02, 0x1B, 0x02, 0x2A, 0x02, 0x23, 0x02, 0x1B, 0x02, 0x12, 0x02, 0x13, 0x02, 0x03, 0x02, 0x12, 0x02, 0x0B, 0x02, 0x03, 0x02, 0x32, 0x01, 0x33, 0x01, 0x03, 0x02, 0x0A, 0x02, 0x12, 0x02, 0x02, 0x02, 0x2A, 0x01, 0x2A, 0x01};
+
+TestResult testBinaryMelody() {
+  testTracesAppend("melody=`%s`\n", tetris);
+
+  // play the text melody as a reference
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, tetris);
+  std::string expected = gMelodyOutput;
+
+  // play the 10 bits binary melody
+  resetTestData();
+  anyrtttl::blocking::playBinary10(BUZZER_PIN, tetris10, sizeof(tetris10));
+  std::string actual = gMelodyOutput;
+  testTracesAppend("actual10=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // play the 16 bits binary melody with the non-blocking api
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::beginBinary16(c, BUZZER_PIN, tetris16, sizeof(tetris16));
+  while( !anyrtttl::nonblocking::done(c) ) // Loop until the melody has played
+  {
+    anyrtttl::nonblocking::play(c);
+    yield(); // prevent watchdog to reset the board.
+  }
+  actual = gMelodyOutput;
+  testTracesAppend("actual16=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // a buffer too small for a control section does not play anything
+  resetTestData();
+  anyrtttl::blocking::playBinary16(BUZZER_PIN, tetris16, 1);
+  ASSERT_STRING_NOT_CONTAINS("tone(pin,", gMelodyOutput.c_str());
+
+  return TestResult::Pass;
+}
+
+TestResult testBinaryEncoder() {
+  testTracesAppend("melody=`%s`\n", tetris);
+
+  // encode the melody with 10 bits per note
+  unsigned char buffer[128] = {0};
+  uint16_t size = anyrtttl::encode10(tetris, NULL, 0);
+  ASSERT_EQ(sizeof(tetris10), size);
+  size = anyrtttl::encode10(tetris, buffer, sizeof(buffer));
+  ASSERT_EQ(sizeof(tetris10), size);
+  ASSERT_TRUE(memcmp(tetris10, buffer, size) == 0);
+
+  // encode the melody with 16 bits per note
+  memset(buffer, 0xFF, sizeof(buffer));
+  size = anyrtttl::encode16(tetris, buffer, sizeof(buffer));
+  ASSERT_EQ(sizeof(tetris16), size);
+  ASSERT_TRUE(memcmp(tetris16, buffer, size) == 0);
+
+  // output buffer too small
+  ASSERT_EQ(0, anyrtttl::encode10(tetris, buffer, sizeof(tetris10) - 1));
+
+  // melodies that cannot be represented in binary format
+  ASSERT_EQ(0, anyrtttl::encode10("bad:d=3,o=5,b=160:c", buffer, sizeof(buffer)));   // invalid default duration
+  ASSERT_EQ(0, anyrtttl::encode10("bad:d=4,o=5,b=1200:c", buffer, sizeof(buffer)));  // bpm larger than 10 bits
+  ASSERT_EQ(0, anyrtttl::encode10("bad:d=4,o=5,b=160:c9", buffer, sizeof(buffer)));  // invalid octave
+  ASSERT_EQ(0, anyrtttl::encode10("bad:d=4,o=5,b=160:c,x", buffer, sizeof(buffer))); // invalid note
+  ASSERT_EQ(0, anyrtttl::encode10("no control section", buffer, sizeof(buffer)));
+
+  // an encoded melody plays exactly like the text melody
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, simpsons);
+  std::string expected = gMelodyOutput;
+  size = anyrtttl::encode10(simpsons, buffer, sizeof(buffer));
+  ASSERT_NE(0, size);
+  resetTestData();
+  anyrtttl::blocking::playBinary10(BUZZER_PIN, buffer, size);
+  std::string actual = gMelodyOutput;
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  return TestResult::Pass;
+}
+
+TestResult testConstexprMelody() {
+  // compile melodies at compile time
+  static constexpr auto tetrisMelody = ANY_RTTTL_MELODY("tetris:d=4,o=5,b=160:e6,8b,8c6,8d6,16e6,16d6,8c6,8b,a,8a,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,2a,8p,d6,8f6,a6,8g6,8f6,e6,8e6,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,a");
+  static constexpr auto simpsonsMelody = ANY_RTTTL_MELODY("Simpsons:d=4,o=5,b=160:32p,c.6,e6,f#6,8a6,g.6,e6,c6,8a,8f#,8f#,8f#,2g");
+  static_assert(tetrisMelody.count() == 42, "unexpected number of notes");
+  static_assert(tetrisMelody.size() == sizeof(tetris16), "unexpected melody size");
+
+  // assert the melody matches the runtime encoder
+  ASSERT_TRUE(memcmp(tetris16, tetrisMelody.data, tetrisMelody.size()) == 0);
+
+  // a long melody compiles without reaching the constexpr recursion limits
+  #define LONG_MELODY_NOTES_X10(s) s s s s s s s s s s
+  #define LONG_MELODY "long:d=4,o=5,b=160:" LONG_MELODY_NOTES_X10(LONG_MELODY_NOTES_X10(LONG_MELODY_NOTES_X10("8c6, d#.,"))) " 2p, "
+  static constexpr auto longMelody = ANY_RTTTL_MELODY(LONG_MELODY);
+  static_assert(longMelody.count() == 2001, "unexpected number of notes");
+  static unsigned char longEncoded[sizeof(longMelody.data)];
+  ASSERT_EQ(sizeof(longEncoded), anyrtttl::encode16(LONG_MELODY, longEncoded, sizeof(longEncoded)));
+  ASSERT_TRUE(memcmp(longEncoded, longMelody.data, longMelody.size()) == 0);
+
+  // assert the melody plays exactly like the text melody
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, simpsons);
+  std::string expected = gMelodyOutput;
+  resetTestData();
+  anyrtttl::blocking::playBinary16(BUZZER_PIN, simpsonsMelody.data, simpsonsMelody.size());
+  std::string actual = gMelodyOutput;
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  return TestResult::Pass;
+}
+
+TestResult testScheduler() {
+  // play a melody with legacy non-blocking api as a reference
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, simpsons);
+  while( !anyrtttl::nonblocking::done(c) )
+  {
+    anyrtttl::nonblocking::play(c);
+  }
+  std::string expected = removeTimestamps(gMelodyOutput);
+
+  // play the same melody with a scheduler
+  anyrtttl::scheduler<3> s;
+  ASSERT_TRUE(s.done());
+  s.poll(); // idle poll does nothing
+  resetTestData();
+  s.begin(0, BUZZER_PIN, simpsons);
+  ASSERT_EQ(1, s.count());
+  while( !s.done() )
+  {
+    s.poll();
+  }
+  std::string actual = removeTimestamps(gMelodyOutput);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // play multiple melodies simultaneously
+  resetTestData();
+  s.begin(0, BUZZER_PIN, simpsons);
+  s.begin(1, BUZZER_PIN, tetris);
+  anyrtttl::nonblocking::beginBinary16(s.context(2), BUZZER_PIN, tetris16, sizeof(tetris16));
+  s.schedule(2);
+  ASSERT_EQ(3, s.count());
+  while( !s.done() )
+  {
+    s.poll();
+  }
+  ASSERT_FALSE(s.isPlaying(0));
+  ASSERT_FALSE(s.isPlaying(1));
+  ASSERT_FALSE(s.isPlaying(2));
+  ASSERT_EQ(simpsons_expected_notes_count + 41 + 41, gTonesPlayedCount); // tetris has 41 tones and 1 pause
+
+  // stop a voice before the end of the melody
+  resetTestData();
+  s.begin(0, BUZZER_PIN, tetris);
+  s.begin(1, BUZZER_PIN, tetris);
+  s.poll();
+  s.stop(1);
+  ASSERT_EQ(1, s.count());
+  ASSERT_TRUE(s.isPlaying(0));
+  ASSERT_FALSE(s.isPlaying(1));
+  while( !s.done() )
+  {
+    s.poll();
+  }
+  ASSERT_EQ(41 + 1, gTonesPlayedCount);
+
+  return TestResult::Pass;
+}
+
+// Plays the given context until the end of the melody and returns the notes without timestamps.
+std::string playToEnd(anyrtttl::rtttl_context_t & c) {
+  while( !anyrtttl::nonblocking::done(c) )
+  {
+    anyrtttl::nonblocking::play(c);
+  }
+  return removeTimestamps(gMelodyOutput);
+}
+
+TestResult testSeek() {
+  static const uint16_t TETRIS_NOTES_COUNT = 42;
+  anyrtttl::rtttl_note_event_t events[TETRIS_NOTES_COUNT];
+  ASSERT_EQ(TETRIS_NOTES_COUNT, anyrtttl::compile(tetris, events, TETRIS_NOTES_COUNT));
+
+  // build a checkpoint every 8 notes
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  anyrtttl::rtttl_seek_point_t points[8];
+  ASSERT_EQ(6, anyrtttl::buildSeekIndex(c, 8, NULL, 0));
+  uint16_t count = anyrtttl::buildSeekIndex(c, 8, points, 8);
+  ASSERT_EQ(6, count);
+  ASSERT_EQ(16, points[2].noteIndex);
+
+  // the reference is the precompiled melody starting at note 20
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, events + 20, TETRIS_NOTES_COUNT - 20);
+  std::string expected = playToEnd(c);
+
+  // seek a text melody with and without the index
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  resetTestData();
+  ASSERT_TRUE(anyrtttl::nonblocking::seekToNote(c, 20, points, count));
+  std::string actual = playToEnd(c);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  resetTestData();
+  ASSERT_TRUE(anyrtttl::nonblocking::seekToNote(c, 20));
+  actual = playToEnd(c);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // seek a binary melody
+  anyrtttl::nonblocking::beginBinary16(c, BUZZER_PIN, tetris16, sizeof(tetris16));
+  count = anyrtttl::buildSeekIndex(c, 8, points, 8);
+  ASSERT_EQ(6, count);
+  resetTestData();
+  ASSERT_TRUE(anyrtttl::nonblocking::seekToNote(c, 20, points, count));
+  actual = playToEnd(c);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // seek to the note playing at a given time. Tones last 1 ms more than their duration.
+  uint32_t startMs = 0;
+  for(uint16_t i=0; i<20; i++)
+    startMs += events[i].duration + (events[i].frequency != NOTE_SILENT ? 1 : 0);
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  ASSERT_EQ(5, anyrtttl::buildSeekIndex(c, 10, points, 8));
+  ASSERT_EQ(startMs, points[2].timeMs);
+  count = anyrtttl::buildSeekIndex(c, 8, points, 8);
+  resetTestData();
+  ASSERT_TRUE(anyrtttl::nonblocking::seekToTime(c, startMs + events[20].duration, points, count));
+  actual = playToEnd(c);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // seek past the end of the melody
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  ASSERT_FALSE(anyrtttl::nonblocking::seekToNote(c, TETRIS_NOTES_COUNT, points, count));
+  ASSERT_FALSE(anyrtttl::nonblocking::seekToTime(c, 0xFFFFFFFFUL, points, count));
+  ASSERT_TRUE(anyrtttl::nonblocking::isPlaying(c));
+
+  return TestResult::Pass;
+}
+
+unsigned long gManualTimer = 0; // a timer that only changes when the test assigns a new value
+
+unsigned long manualTimer(void) {
+  return gManualTimer;
+}
+
+TestResult testMicrosTiming() {
+  // 7 eighth notes at 140 bpm last exactly 1.5 seconds.
+  // Each note lasts 214285.714 microseconds.
+  static const char * melody = "drift:d=8,o=5,b=140:c,d,e,f,g,a,b";
+  static const unsigned long MELODY_LENGTH_US = 1500000;
+  static const unsigned long START_US = 1000;
+  static const unsigned long LATE_US = 300; // play() is always called late
+
+  anyrtttl::setMicrosFunction(&manualTimer);
+  anyrtttl::setTimingMode(anyrtttl::RTTTL_TIMING_MICROS);
+
+  resetTestData();
+  gManualTimer = START_US;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody);
+  anyrtttl::nonblocking::play(c);
+  while( !anyrtttl::nonblocking::done(c) )
+  {
+    // the note must not change before its end
+    gManualTimer = c.nextNoteUs - 1;
+    uint16_t count = gTonesPlayedCount;
+    anyrtttl::nonblocking::play(c);
+    ASSERT_EQ(count, gTonesPlayedCount);
+
+    gManualTimer = c.nextNoteUs + LATE_US;
+    anyrtttl::nonblocking::play(c);
+  }
+  ASSERT_EQ(7, gTonesPlayedCount);
+
+  // assert the delays in calling play() did not accumulate
+  ASSERT_EQ(START_US + MELODY_LENGTH_US, c.nextNoteUs);
+
+  // the length of a note with too many dots saturates instead of overflowing
+  gManualTimer = START_US;
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, "dots:d=1,o=5,b=1:c..........");
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(4100625000UL, c.nextNoteUs - START_US); // the length of a whole note with 7 dots
+  anyrtttl::nonblocking::stop(c);
+
+  anyrtttl::setTimingMode(anyrtttl::RTTTL_TIMING_MILLIS);
+  anyrtttl::setMicrosFunction(&micros);
+
+  return TestResult::Pass;
+}
+
+TestResult testMillisWraparound() {
+  static const char * melody = "wrap:d=4,o=5,b=160:c,d";
+
+  anyrtttl::setMillisFunction(&manualTimer);
+
+  // start playing 100 ms before millis() wraps around
+  resetTestData();
+  gManualTimer = 0xFFFFFFFFUL - 100;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody);
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(1, gTonesPlayedCount);
+
+  // the first note ends after the wraparound
+  gManualTimer = 0xFFFFFFFFUL - 50;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(1, gTonesPlayedCount);
+  gManualTimer = 200;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(1, gTonesPlayedCount);
+
+  // the second note plays at the end of the first note
+  gManualTimer = c.nextNoteMs;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(2, gTonesPlayedCount);
+
+  anyrtttl::setMillisFunction(&fakeMillis);
+
+  return TestResult::Pass;
+}
+
+TestResult testBoundedParsing() {
+  // the melody is not terminated after the first 2 notes
+  static const char * melody = "tetris:d=4,o=5,b=160:e6,8b,8c6,8d6";
+  static const uint16_t length = 26; // "tetris:d=4,o=5,b=160:e6,8b"
+
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody, length);
+  while (anyrtttl::nonblocking::isPlaying(c))
+    anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(2, gTonesPlayedCount);
+  ASSERT_STRING_CONTAINS("tone(pin,1319,375);", gMelodyOutput.c_str());
+  ASSERT_STRING_CONTAINS("tone(pin,988,187);", gMelodyOutput.c_str());
+
+  // a melody without control section is not played
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, "tetris");
+  ASSERT_FALSE(anyrtttl::nonblocking::isPlaying(c));
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody, 6);
+  ASSERT_FALSE(anyrtttl::nonblocking::isPlaying(c));
+
+  // the control section ends with the melody
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody, 16); // "tetris:d=4,o=5,b"
+  while (anyrtttl::nonblocking::isPlaying(c))
+    anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(0, gTonesPlayedCount);
+
+  // invalid values are ignored
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, "zero:d=4,o=5,b=0:c6");
+  while (anyrtttl::nonblocking::isPlaying(c))
+    anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(anyrtttl::RTTTL_DEFAULT_BPM_VALUE, c.bpm);
+  ASSERT_EQ(1, gTonesPlayedCount);
+
+  // a melody that ends with a '\0' character is not limited to RTTTL_UNBOUNDED_LENGTH bytes
+  std::string longMelody = "long:d=4,o=5,b=900:";
+  for(uint16_t i=0; i<33000; i++)
+    longMelody += "c,";
+  longMelody += "e";
+  ASSERT_TRUE(longMelody.size() > anyrtttl::RTTTL_UNBOUNDED_LENGTH);
+  ASSERT_EQ(33001, anyrtttl::compile(longMelody.c_str(), NULL, 0));
+
+  return TestResult::Pass;
+}
+
+unsigned long gSleepCount = 0;
+unsigned long gSleepTotal = 0;
+
+// A sleep function which moves the manual timer forward.
+void manualSleep(unsigned long iMillis) {
+  gSleepCount++;
+  gSleepTotal += iMillis;
+  gManualTimer += iMillis;
+}
+
+TestResult testSleep() {
+  static const char * melody = "sleep:d=4,o=5,b=160:c,8p,d";
+
+  anyrtttl::setMillisFunction(&manualTimer);
+
+  // time until the next note
+  resetTestData();
+  gManualTimer = 1000;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, melody);
+  ASSERT_EQ(0, anyrtttl::nonblocking::millisUntilNextEvent(c)); // the first note is due
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(376, anyrtttl::nonblocking::millisUntilNextEvent(c));
+  gManualTimer += 100;
+  ASSERT_EQ(276, anyrtttl::nonblocking::millisUntilNextEvent(c));
+  anyrtttl::nonblocking::pause(c);
+  ASSERT_EQ(anyrtttl::RTTTL_NO_EVENT, anyrtttl::nonblocking::millisUntilNextEvent(c));
+  anyrtttl::nonblocking::resume(c);
+  ASSERT_EQ(276, anyrtttl::nonblocking::millisUntilNextEvent(c));
+  gManualTimer += 300;
+  ASSERT_EQ(0, anyrtttl::nonblocking::millisUntilNextEvent(c));
+  anyrtttl::nonblocking::stop(c);
+  ASSERT_EQ(anyrtttl::RTTTL_NO_EVENT, anyrtttl::nonblocking::millisUntilNextEvent(c));
+
+  // the blocking api sleeps until the end of each note. The timer only moves while sleeping.
+  resetTestData();
+  gSleepCount = 0;
+  gSleepTotal = 0;
+  anyrtttl::setSleepFunction(&manualSleep);
+  anyrtttl::blocking::play(BUZZER_PIN, melody);
+  anyrtttl::setSleepFunction(NULL);
+  ASSERT_EQ(2, gTonesPlayedCount);
+  ASSERT_EQ(3, gSleepCount);
+  ASSERT_EQ(376 + 187 + 376, gSleepTotal);
+
+  // the scheduler returns the time until the earliest note
+  resetTestData();
+  anyrtttl::scheduler<2> s;
+  ASSERT_EQ(anyrtttl::RTTTL_NO_EVENT, s.millisUntilNextEvent());
+  s.begin(0, BUZZER_PIN, melody);
+  s.begin(1, BUZZER_PIN, "short:d=8,o=5,b=160:c");
+  s.poll();
+  ASSERT_EQ(188, s.millisUntilNextEvent());
+  gManualTimer += 188;
+  s.poll();
+  ASSERT_EQ(376 - 188, s.millisUntilNextEvent());
+
+  anyrtttl::setMillisFunction(&fakeMillis);
+
+  return TestResult::Pass;
+}
+
+uint16_t gOutputTones[2] = {0, 0};   // number of tone() calls of each output of testOutput().
+uint16_t gOutputNoTones[2] = {0, 0}; // number of noTone() calls of each output of testOutput().
+
+void toneOutput0(uint8_t pin, unsigned int frequency, unsigned long duration) { gOutputTones[0]++; }
+void toneOutput1(uint8_t pin, unsigned int frequency, unsigned long duration) { gOutputTones[1]++; }
+void noToneOutput0(uint8_t pin) { gOutputNoTones[0]++; }
+void noToneOutput1(uint8_t pin) { gOutputNoTones[1]++; }
+
+TestResult testOutput() {
+  static const anyrtttl::rtttl_output_t outputs[2] = {
+    { &toneOutput0, &noToneOutput0 },
+    { &toneOutput1, &noToneOutput1 },
+  };
+
+  // play two melodies simultaneously, each on its own output
+  resetTestData();
+  anyrtttl::rtttl_context_t c0 = {0};
+  anyrtttl::rtttl_context_t c1 = {0};
+  anyrtttl::nonblocking::begin(c0, BUZZER_PIN, simpsons, &outputs[0]);
+  anyrtttl::nonblocking::begin(c1, BUZZER_PIN+1, tetris, &outputs[1]);
+  while( !anyrtttl::nonblocking::done(c0) || !anyrtttl::nonblocking::done(c1) )
+  {
+    anyrtttl::nonblocking::play(c0);
+    anyrtttl::nonblocking::play(c1);
+  }
+  ASSERT_EQ(simpsons_expected_notes_count, gOutputTones[0]);
+  ASSERT_EQ(41, gOutputTones[1]); // tetris has 41 tones and 1 pause
+  ASSERT_EQ(1 + 2, gOutputNoTones[0]); // a noTone() per pause (simpsons starts with a pause) plus begin() and the end of the melody
+  ASSERT_EQ(1 + 2, gOutputNoTones[1]);
+  ASSERT_EQ(0, gTonesPlayedCount); // nothing is played with the global functions
+
+  // any begin() function can play on an output
+  anyrtttl::nonblocking::beginBinary16(c1, BUZZER_PIN+1, tetris16, sizeof(tetris16), &outputs[1]);
+  playToEnd(c1);
+  ASSERT_EQ(41 + 41, gOutputTones[1]);
+  ASSERT_EQ(0, gTonesPlayedCount);
+
+  // a scheduler voice plays on the output given to its begin() function
+  anyrtttl::scheduler<2> s;
+  s.begin(0, BUZZER_PIN, tetris, &outputs[0]);
+  s.begin(1, BUZZER_PIN+1, tetris, &outputs[1]);
+  while( !s.done() )
+  {
+    s.poll();
+  }
+  ASSERT_EQ(simpsons_expected_notes_count + 41, gOutputTones[0]);
+  ASSERT_EQ(41 + 41 + 41, gOutputTones[1]);
+  ASSERT_EQ(0, gTonesPlayedCount);
+
+  // without an output, the melody plays with the global functions.
+  // begin() does not read the previous state of the context.
+  anyrtttl::rtttl_context_t c2;
+  memset(&c2, 0xA5, sizeof(c2));
+  anyrtttl::nonblocking::begin(c2, BUZZER_PIN, simpsons);
+  playToEnd(c2);
+  ASSERT_EQ(simpsons_expected_notes_count + 41, gOutputTones[0]);
+  ASSERT_EQ(simpsons_expected_notes_count, gTonesPlayedCount);
+
+  // an incomplete output is refused by begin()
+  static const anyrtttl::rtttl_output_t incomplete = { &toneOutput0, NULL };
+  anyrtttl::nonblocking::begin(c0, BUZZER_PIN, simpsons, &incomplete);
+  ASSERT_FALSE(anyrtttl::nonblocking::isPlaying(c0));
+  anyrtttl::nonblocking::play(c0);
+  anyrtttl::nonblocking::stop(c0);
+  ASSERT_EQ(simpsons_expected_notes_count + 41, gOutputTones[0]);
+
+  return TestResult::Pass;
+}
+
+std::string gLedcOutput; // calls to the mock LEDC functions of testChannelPool().
+uint16_t gLedcWriteCount = 0;
+
+void mockLedcAttach(uint8_t pin, uint8_t channel) { stringPrintf(gLedcOutput, "attach(%d,%d);", pin, channel); }
+void mockLedcDetach(uint8_t pin) { stringPrintf(gLedcOutput, "detach(%d);", pin); }
+void mockLedcWriteTone(uint8_t pin, uint8_t channel, unsigned int frq) { stringPrintf(gLedcOutput, "write(%d,%d,%d);", pin, channel, frq); gLedcWriteCount++; }
+
+TestResult testChannelPool() {
+  esp32::setLedcFunctions(&mockLedcAttach, &mockLedcDetach, &mockLedcWriteTone);
+
+  // each pin gets its own channel and timer the first time it is used
+  gLedcOutput.clear();
+  esp32::poolTone(25, 440, 100);
+  esp32::poolTone(32, 880, 100);
+  ASSERT_STRING_EQ("attach(25,0);write(25,0,440);attach(32,2);write(32,2,880);", gLedcOutput.c_str());
+  ASSERT_EQ(0, esp32::getPoolChannel(25));
+  ASSERT_EQ(2, esp32::getPoolChannel(32));
+  ASSERT_EQ(ESP32_INVALID_CHANNEL, esp32::getPoolChannel(26));
+
+  // redundant writes are skipped
+  gLedcOutput.clear();
+  esp32::poolTone(25, 440, 100);
+  esp32::poolNoTone(25);
+  esp32::poolNoTone(25);
+  esp32::poolNoTone(26); // no channel
+  ASSERT_STRING_EQ("write(25,0,0);", gLedcOutput.c_str());
+
+  // the channel of a silent pin is assigned to a new pin when the pool is full
+  esp32::poolTone(26, 440, 100);
+  esp32::poolTone(27, 440, 100);
+  gLedcOutput.clear();
+  esp32::poolTone(33, 440, 100);
+  ASSERT_STRING_EQ("detach(25);attach(33,0);write(33,0,440);", gLedcOutput.c_str());
+  ASSERT_EQ(ESP32_INVALID_CHANNEL, esp32::getPoolChannel(25));
+
+  // tones are ignored while all channels are playing
+  gLedcOutput.clear();
+  esp32::poolTone(34, 440, 100);
+  ASSERT_STRING_EQ("", gLedcOutput.c_str());
+  esp32::releaseChannel(32);
+  ASSERT_STRING_EQ("write(32,2,0);detach(32);", gLedcOutput.c_str());
+  esp32::poolTone(34, 440, 100);
+  ASSERT_EQ(2, esp32::getPoolChannel(34));
+
+  // a write is expected each time the frequency of tetris changes, including its pause and the end of the melody.
+  // Repeated notes are not written again.
+  anyrtttl::rtttl_note_event_t events[42];
+  ASSERT_EQ(42, anyrtttl::compile(tetris, events, 42));
+  uint16_t expectedWrites = 0;
+  uint16_t previous = NOTE_SILENT;
+  for(uint16_t i=0; i<42; i++)
+  {
+    if (events[i].frequency != previous)
+      expectedWrites++;
+    previous = events[i].frequency;
+  }
+  if (previous != NOTE_SILENT)
+    expectedWrites++;
+  ASSERT_TRUE(expectedWrites < 41 + 2); // less than a write per tone plus the pause and the end of the melody
+
+  // play two melodies simultaneously with the pool
+  esp32::releaseAllChannels();
+  static const anyrtttl::rtttl_output_t pool = { &esp32::poolTone, &esp32::poolNoTone };
+  anyrtttl::rtttl_context_t c0 = {0};
+  anyrtttl::rtttl_context_t c1 = {0};
+  anyrtttl::nonblocking::begin(c0, 25, tetris, &pool);
+  anyrtttl::nonblocking::begin(c1, 32, tetris, &pool);
+  gLedcWriteCount = 0;
+  while( !anyrtttl::nonblocking::done(c0) || !anyrtttl::nonblocking::done(c1) )
+  {
+    anyrtttl::nonblocking::play(c0);
+    anyrtttl::nonblocking::play(c1);
+    ASSERT_NE(esp32::getPoolChannel(25), esp32::getPoolChannel(32));
+  }
+  ASSERT_EQ(2 * expectedWrites, gLedcWriteCount);
+
+  esp32::setLedcFunctions(NULL, NULL, NULL);
+
+  return TestResult::Pass;
+}
+
+TestResult testLoop() {
+  // play the melody once as a reference
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, simpsons);
+  playToEnd(c);
+  size_t noToneCount = countTokens("noTone(", gMelodyOutput.c_str());
+
+  // repeat the whole melody 2 times
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, simpsons);
+  ASSERT_TRUE(anyrtttl::nonblocking::setLoop(c, 2));
+  playToEnd(c);
+  ASSERT_EQ(3 * simpsons_expected_notes_count, gTonesPlayedCount);
+  ASSERT_EQ(noToneCount + 2 * 1, countTokens("noTone(", gMelodyOutput.c_str())); // the melody is not restarted. simpsons has a single pause.
+
+  // repeat notes 2 and 3 of text and binary melodies 3 times
+  resetTestData();
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  ASSERT_TRUE(anyrtttl::nonblocking::setLoop(c, 3, 2, 4));
+  std::string expected = playToEnd(c);
+  ASSERT_EQ(41 + 3 * 2, gTonesPlayedCount); // tetris has 41 tones and 1 pause
+  ASSERT_STRING_CONTAINS("tone(pin,1047,187);\ntone(pin,1175,187);\ntone(pin,1047,187);", expected.c_str());
+
+  resetTestData();
+  anyrtttl::nonblocking::beginBinary16(c, BUZZER_PIN, tetris16, sizeof(tetris16));
+  ASSERT_TRUE(anyrtttl::nonblocking::setLoop(c, 3, 2, 4));
+  std::string actual = playToEnd(c);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // invalid loops
+  ASSERT_FALSE(anyrtttl::nonblocking::setLoop(c, 1, 4, 2));
+  ASSERT_FALSE(anyrtttl::nonblocking::setLoop(c, 1, 42, anyrtttl::RTTTL_LOOP_END));
+
+  // loop forever without gap. Each play() at the end of a note plays the next note.
+  anyrtttl::setMillisFunction(&manualTimer);
+  resetTestData();
+  gManualTimer = 1000;
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, "loop:d=4,o=5,b=160:c,d");
+  ASSERT_TRUE(anyrtttl::nonblocking::setLoop(c, anyrtttl::RTTTL_LOOP_FOREVER));
+  for(unsigned long i=1; i<=100; i++)
+  {
+    gManualTimer = c.nextNoteMs;
+    anyrtttl::nonblocking::play(c);
+    ASSERT_EQ(i, gTonesPlayedCount);
+  }
+  ASSERT_TRUE(anyrtttl::nonblocking::isPlaying(c));
+  anyrtttl::nonblocking::stop(c);
+  anyrtttl::setMillisFunction(&fakeMillis);
+
+  return TestResult::Pass;
+}
+
+// A catalog of tetris, Simpsons and beep melodies encoded with 16 bits per note. Generated with anyrtttl_catalog.
+static const unsigned char catalog16[] = {
+  0x52, 0x54, 0x43, 0x31, 0x03, 0x00, 0x00, 0x00, 0x68, 0x5F, 0x79, 0x28, 0x2C, 0x00, 0x00, 0x00,
+  0x56, 0x00, 0x03, 0x00, 0x31, 0x5F, 0xD7, 0x53, 0x82, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x03, 0x00,
+  0x9D, 0x6F, 0x5B, 0xA4, 0x9E, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x0A, 0x14, 0x12, 0x02,
+  0x33, 0x01, 0x03, 0x02, 0x0B, 0x02, 0x14, 0x02, 0x0C, 0x02, 0x03, 0x02, 0x33, 0x01, 0x2A, 0x01,
+  0x2B, 0x01, 0x03, 0x02, 0x12, 0x02, 0x0B, 0x02, 0x03, 0x02, 0x32, 0x01, 0x33, 0x01, 0x03, 0x02,
+  0x0A, 0x02, 0x12, 0x02, 0x02, 0x02, 0x2A, 0x01, 0x29, 0x01, 0x3B, 0x01, 0x0A, 0x02, 0x1B, 0x02,
+  0x2A, 0x02, 0x23, 0x02, 0x1B, 0x02, 0x12, 0x02, 0x13, 0x02, 0x03, 0x02, 0x12, 0x02, 0x0B, 0x02,
+  0x03, 0x02, 0x32, 0x01, 0x33, 0x01, 0x03, 0x02, 0x0A, 0x02, 0x12, 0x02, 0x02, 0x02, 0x2A, 0x01,
+  0x2A, 0x01, 0x0A, 0x14, 0x3D, 0x01, 0x82, 0x02, 0x12, 0x02, 0x5A, 0x02, 0x2B, 0x02, 0xA2, 0x02,
+  0x12, 0x02, 0x02, 0x02, 0x2B, 0x01, 0x5B, 0x01, 0x5B, 0x01, 0x5B, 0x01, 0x21, 0x01, 0x13, 0x1E,
+  0x03, 0x02, 0x13, 0x02, 0x03, 0x03
+};
+
+unsigned long gSteppingMicros = 0;
+
+unsigned long steppingMicros(void) {
+  gSteppingMicros += 5; // each call takes 5 us
+  return gSteppingMicros;
+}
+
+TestResult testTelemetry() {
+  anyrtttl::setMillisFunction(&manualTimer);
+  anyrtttl::setMicrosFunction(&steppingMicros);
+
+  resetTestData();
+  gManualTimer = 1000;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  anyrtttl::nonblocking::play(c);
+
+  // play the second note 7 ms late and the third note 3 ms late
+  gManualTimer = c.nextNoteMs + 7;
+  anyrtttl::nonblocking::play(c);
+  gManualTimer = c.nextNoteMs - 10;
+  anyrtttl::nonblocking::play(c);
+  gManualTimer = c.nextNoteMs + 3;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(3, gTonesPlayedCount);
+
+  if (anyrtttl::telemetry::isEnabled())
+  {
+    ASSERT_EQ(3, anyrtttl::telemetry::getNotesPlayed(c));
+    ASSERT_EQ(7, anyrtttl::telemetry::getMaxLateness(c));
+    ASSERT_EQ(5, anyrtttl::telemetry::getMeanLateness(c));
+    ASSERT_EQ(376 + 7, anyrtttl::telemetry::getMaxPollGap(c)); // the first note is 375 ms plus 1 ms of silence
+    ASSERT_EQ(5, anyrtttl::telemetry::getMaxParseTime(c));
+    ASSERT_EQ(5, anyrtttl::telemetry::getMeanParseTime(c));
+
+    // statistics are reset when a melody begins
+    anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+    ASSERT_EQ(0, anyrtttl::telemetry::getNotesPlayed(c));
+    ASSERT_EQ(0, anyrtttl::telemetry::getMaxPollGap(c));
+  }
+  else
+  {
+    ASSERT_EQ(0, anyrtttl::telemetry::getNotesPlayed(c));
+    ASSERT_EQ(0, anyrtttl::telemetry::getMaxLateness(c));
+  }
+
+  anyrtttl::setMillisFunction(&fakeMillis);
+  anyrtttl::setMicrosFunction(&micros);
+
+  return TestResult::Pass;
+}
+
+TestResult testTrace() {
+  anyrtttl::setMillisFunction(&manualTimer);
+
+  resetTestData();
+  anyrtttl::trace::clear();
+  gManualTimer = 1000;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  anyrtttl::nonblocking::play(c);
+
+  // play the second note 5 ms late and stop the melody
+  gManualTimer = c.nextNoteMs + 5;
+  anyrtttl::nonblocking::play(c);
+  anyrtttl::nonblocking::stop(c);
+  ASSERT_EQ(2, gTonesPlayedCount);
+
+  unsigned char buffer[128];
+  uint16_t size = anyrtttl::trace::dump(buffer, sizeof(buffer));
+  ASSERT_EQ(anyrtttl::RTTTL_TRACE_HEADER_SIZE + anyrtttl::trace::getCount() * anyrtttl::RTTTL_TRACE_RECORD_SIZE, size);
+  ASSERT_EQ('R', buffer[0]);
+  ASSERT_EQ('T', buffer[1]);
+
+  if (anyrtttl::trace::isEnabled())
+  {
+    static const byte expected_events[] = {
+      anyrtttl::RTTTL_TRACE_BEGIN,
+      anyrtttl::RTTTL_TRACE_NOTE_START,
+      anyrtttl::RTTTL_TRACE_NOTE_END,
+      anyrtttl::RTTTL_TRACE_LATE_POLL,
+      anyrtttl::RTTTL_TRACE_NOTE_START,
+      anyrtttl::RTTTL_TRACE_STOP,
+    };
+    static const uint16_t expected_values[] = { anyrtttl::RTTTL_FORMAT_TEXT, NOTE_E6, 0, 5, NOTE_B5, 2 };
+    ASSERT_EQ(sizeof(expected_events), anyrtttl::trace::getCount());
+    for(uint16_t i=0; i<anyrtttl::trace::getCount(); i++)
+    {
+      anyrtttl::rtttl_trace_record_t r;
+      ASSERT_TRUE(anyrtttl::trace::getRecord(i, r));
+      testTracesAppend("record %d: time=%lu event=%d value=%d\n", (int)i, (unsigned long)r.time, (int)r.event, (int)r.value);
+      ASSERT_EQ(expected_events[i], r.event);
+      ASSERT_EQ(expected_values[i], r.value);
+      ASSERT_EQ(BUZZER_PIN, r.pin);
+    }
+
+    // the oldest records are overwritten
+    for(int i=0; i<ANY_RTTTL_TRACE_SIZE; i++)
+    {
+      anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris); // a single record per call
+    }
+    ASSERT_EQ(ANY_RTTTL_TRACE_SIZE, anyrtttl::trace::getCount());
+    ASSERT_EQ(sizeof(expected_events), anyrtttl::trace::getOverwritten());
+  }
+  else
+  {
+    ASSERT_EQ(0, anyrtttl::trace::getCount());
+  }
+
+  anyrtttl::setMillisFunction(&fakeMillis);
+
+  return TestResult::Pass;
+}
+
+TestResult testCatalog() {
+  ASSERT_EQ(3, anyrtttl::catalog::getCount(catalog16));
+  ASSERT_EQ(0, anyrtttl::catalog::getCount(tetris16)); // not a catalog
+
+  // find melodies by name
+  anyrtttl::rtttl_catalog_melody_t melody;
+  ASSERT_TRUE(anyrtttl::catalog::findByName(catalog16, "tetris", melody));
+  ASSERT_EQ(anyrtttl::RTTTL_FORMAT_BINARY16, melody.format);
+  ASSERT_EQ(sizeof(tetris16), melody.size);
+  ASSERT_TRUE(memcmp(tetris16, melody.buffer, melody.size) == 0);
+  ASSERT_TRUE(anyrtttl::catalog::findByName(catalog16, "beep", melody));
+  ASSERT_FALSE(anyrtttl::catalog::findByName(catalog16, "Tetris", melody));
+  ASSERT_FALSE(anyrtttl::catalog::findByName(catalog16, "", melody));
+
+  // names can be hashed at compile time
+  static constexpr uint32_t SIMPSONS_HASH = anyrtttl::catalog::getNameHash("Simpsons");
+  ASSERT_TRUE(anyrtttl::catalog::findByHash(catalog16, SIMPSONS_HASH, melody));
+
+  // a melody of the catalog plays exactly like the text melody
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, simpsons);
+  std::string expected = removeTimestamps(gMelodyOutput);
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::catalog::begin(c, BUZZER_PIN, melody);
+  std::string actual = playToEnd(c);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // a text melody is not read past its size
+  static const char truncated[] = "tetris:d=4,o=5,b=160:e6,8b,8c6,8d6,16e6,16d6,8c6,8b,a,8a,8c6,e6,8d6,8c6,b,8b,8c6,d6,e6,c6,a,2a,8p,d6";
+  resetTestData();
+  anyrtttl::rtttl_catalog_melody_t text = { (const unsigned char *)tetris, (uint16_t)(sizeof(truncated) - 1), anyrtttl::RTTTL_FORMAT_TEXT };
+  anyrtttl::catalog::begin(c, BUZZER_PIN, text);
+  playToEnd(c);
+  ASSERT_EQ(23, gTonesPlayedCount); // the tones of truncated
+
+  // get melodies by id
+  for(uint16_t i=0; i<3; i++)
+  {
+    ASSERT_TRUE(anyrtttl::catalog::getById(catalog16, i, melody));
+  }
+  ASSERT_FALSE(anyrtttl::catalog::getById(catalog16, 3, melody));
+
+  return TestResult::Pass;
+}
+
+TestResult testStream() {
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, tetris);
+  std::string expected = removeTimestamps(gMelodyOutput);
+
+  // playback waits for the first notes
+  resetTestData();
+  anyrtttl::rtttl_stream_t s;
+  anyrtttl::stream::init(s);
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::beginStream(c, BUZZER_PIN, s);
+  for(int i=0; i<10; i++)
+  {
+    anyrtttl::nonblocking::play(c);
+  }
+  ASSERT_TRUE(anyrtttl::nonblocking::isPlaying(c));
+  ASSERT_EQ(0, gTonesPlayedCount);
+
+  // feed the melody in chunks of 5 characters while playing
+  const char * next = tetris;
+  size_t remaining = strlen(tetris);
+  while (remaining > 0)
+  {
+    uint16_t size = (remaining < 5 ? (uint16_t)remaining : 5);
+    uint16_t consumed = anyrtttl::stream::feed(s, next, size);
+    next += consumed;
+    remaining -= consumed;
+    anyrtttl::nonblocking::play(c);
+  }
+  while (!anyrtttl::stream::end(s))
+  {
+    anyrtttl::nonblocking::play(c); // the last note is queued when a note is played
+  }
+  std::string actual = playToEnd(c);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+  ASSERT_FALSE(anyrtttl::stream::hasError(s));
+
+  // the parser stops when the queue is full
+  anyrtttl::stream::init(s);
+  uint16_t consumed = anyrtttl::stream::feed(s, tetris);
+  ASSERT_TRUE(consumed < strlen(tetris));
+  ASSERT_EQ(anyrtttl::RTTTL_STREAM_QUEUE_SIZE, anyrtttl::stream::available(s));
+
+  // a note longer than the parser's buffer is an error
+  anyrtttl::stream::init(s);
+  anyrtttl::stream::feed(s, "long:d=4,o=5,b=100:c,d,                                e,f");
+  ASSERT_TRUE(anyrtttl::stream::hasError(s));
+  ASSERT_TRUE(anyrtttl::stream::isEnded(s));
+  ASSERT_EQ(2, anyrtttl::stream::available(s));
+
+  return TestResult::Pass;
+}
+
+TestResult testWire() {
+  resetTestData();
+  anyrtttl::blocking::play(BUZZER_PIN, tetris);
+  std::string expected = removeTimestamps(gMelodyOutput);
+
+  // encode the melody as frames
+  unsigned char binary[128] = {0};
+  uint16_t binarySize = anyrtttl::encode10(tetris, binary, sizeof(binary));
+  unsigned char frames[256] = {0};
+  uint16_t size = anyrtttl::wire::encode(binary, binarySize, 10, NULL, 0);
+  ASSERT_TRUE(size > 0);
+  ASSERT_EQ(size, anyrtttl::wire::encode(binary, binarySize, 10, frames, sizeof(frames)));
+  ASSERT_EQ(0, anyrtttl::wire::encode(binary, binarySize, 10, frames, size - 1));
+  ASSERT_EQ(0, anyrtttl::wire::encode(binary, binarySize, 12, frames, sizeof(frames)));
+  testTracesAppend("binary=%d bytes, frames=%d bytes\n", (int)binarySize, (int)size);
+
+  // feed the frames in chunks of 7 bytes while playing
+  resetTestData();
+  anyrtttl::rtttl_wire_t w;
+  anyrtttl::rtttl_stream_t s;
+  anyrtttl::wire::init(w, s);
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::beginStream(c, BUZZER_PIN, s);
+  const unsigned char * next = frames;
+  uint16_t remaining = size;
+  while (remaining > 0)
+  {
+    uint16_t consumed = anyrtttl::wire::feed(w, next, (remaining < 7 ? remaining : 7));
+    next += consumed;
+    remaining -= consumed;
+    anyrtttl::nonblocking::play(c);
+  }
+  std::string actual = playToEnd(c);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+  ASSERT_EQ(0, w.errors);
+
+  // a corrupted frame is dropped and the rest of the melody is played
+  frames[15] ^= 0x01; // a note of the first NOTES frame
+  resetTestData();
+  anyrtttl::wire::init(w, s);
+  anyrtttl::nonblocking::beginStream(c, BUZZER_PIN, s);
+  next = frames;
+  remaining = size;
+  while (remaining > 0)
+  {
+    uint16_t consumed = anyrtttl::wire::feed(w, next, remaining);
+    next += consumed;
+    remaining -= consumed;
+    anyrtttl::nonblocking::play(c);
+  }
+  playToEnd(c);
+  ASSERT_TRUE(anyrtttl::stream::isEnded(s));
+  ASSERT_EQ(2, w.errors); // the corrupted frame and the sequence gap
+  ASSERT_TRUE(gTonesPlayedCount > 0);
+  frames[15] ^= 0x01;
+
+  // the bytes of a corrupted frame are scanned again for the next frame
+  static const uint16_t LAST_NOTES_LENGTH_OFFSET = 9 + 46 + 3; // after the START frame and a full NOTES frame
+  ASSERT_EQ(13, frames[LAST_NOTES_LENGTH_OFFSET]);
+  frames[LAST_NOTES_LENGTH_OFFSET] = 20; // the corrupted frame covers the END frame
+  resetTestData();
+  anyrtttl::wire::init(w, s);
+  anyrtttl::nonblocking::beginStream(c, BUZZER_PIN, s);
+  next = frames;
+  remaining = size;
+  while (remaining > 0)
+  {
+    uint16_t consumed = anyrtttl::wire::feed(w, next, remaining);
+    next += consumed;
+    remaining -= consumed;
+    anyrtttl::nonblocking::play(c);
+  }
+  static const unsigned char idle[3] = {0}; // completes the corrupted frame
+  anyrtttl::wire::feed(w, idle, sizeof(idle));
+  ASSERT_TRUE(anyrtttl::stream::isEnded(s));
+  ASSERT_EQ(2, w.errors); // the corrupted frame and the sequence gap
+  playToEnd(c);
+  ASSERT_EQ(31, gTonesPlayedCount); // the 32 notes of the first NOTES frame have 31 tones and a pause
+  frames[LAST_NOTES_LENGTH_OFFSET] = 13;
+
+  // a melody ends when its END frame is lost
+  resetTestData();
+  anyrtttl::wire::init(w, s);
+  anyrtttl::nonblocking::beginStream(c, BUZZER_PIN, s);
+  next = frames;
+  remaining = size - anyrtttl::RTTTL_WIRE_FRAME_OVERHEAD;
+  while (remaining > 0)
+  {
+    uint16_t consumed = anyrtttl::wire::feed(w, next, remaining);
+    next += consumed;
+    remaining -= consumed;
+    anyrtttl::nonblocking::play(c);
+  }
+  ASSERT_FALSE(anyrtttl::stream::isEnded(s));
+  while( !anyrtttl::nonblocking::done(c) )
+  {
+    anyrtttl::wire::feed(w, NULL, 0);
+    anyrtttl::nonblocking::play(c);
+  }
+  ASSERT_EQ(1, w.errors);
+  actual = removeTimestamps(gMelodyOutput);
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  return TestResult::Pass;
+}
+
+unsigned long gCharactersReadCount = 0;
+
+char countingReadChar(const char * iBuffer) {
+  gCharactersReadCount++;
+  return *iBuffer;
+}
+
+TestResult testPauseResume() {
+  anyrtttl::setMillisFunction(&manualTimer);
+
+  // play the first note of tetris: e6 for 375 ms
+  resetTestData();
+  gManualTimer = 1000;
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris);
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(1, gTonesPlayedCount);
+
+  // pause in the middle of the note
+  gManualTimer = 1100;
+  size_t noToneCount = countTokens("noTone(", gMelodyOutput.c_str());
+  anyrtttl::nonblocking::pause(c);
+  ASSERT_TRUE(anyrtttl::nonblocking::isPaused(c));
+  ASSERT_TRUE(anyrtttl::nonblocking::isPlaying(c));
+  ASSERT_FALSE(anyrtttl::nonblocking::done(c));
+  ASSERT_EQ(noToneCount + 1, countTokens("noTone(", gMelodyOutput.c_str())); // the buzzer is silenced
+
+  // no note is played while paused
+  gManualTimer = 5000;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(1, gTonesPlayedCount);
+
+  // resume plays the rest of the note
+  anyrtttl::nonblocking::resume(c);
+  ASSERT_FALSE(anyrtttl::nonblocking::isPaused(c));
+  ASSERT_EQ(2, gTonesPlayedCount);
+  ASSERT_STRING_CONTAINS("tone(pin,1319,275);", gMelodyOutput.c_str());
+
+  // the next note starts after the time that was left
+  gManualTimer = 5275;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(2, gTonesPlayedCount);
+  gManualTimer = 5276;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(3, gTonesPlayedCount);
+
+  // stop does not read the rest of the melody
+  gCharactersReadCount = 0;
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, tetris, &countingReadChar);
+  anyrtttl::nonblocking::play(c);
+  unsigned long count = gCharactersReadCount;
+  anyrtttl::nonblocking::stop(c);
+  ASSERT_EQ(count, gCharactersReadCount);
+  ASSERT_TRUE(anyrtttl::nonblocking::done(c));
+  gManualTimer += 1000;
+  anyrtttl::nonblocking::play(c);
+  ASSERT_EQ(count, gCharactersReadCount);
+
+  anyrtttl::setMillisFunction(&fakeMillis);
+
+  return TestResult::Pass;
+}
+
+#if defined(__linux__)
+// A simulated timer source for the timer engine. A thread calls the callback once per period.
+std::thread gSimulatedTimerThread;
+std::atomic<bool> gSimulatedTimerRunning(false);
+
+void simulatedTimerStop() {
+  gSimulatedTimerRunning = false;
+
+  // the timer may be stopped from the callback function
+  if (gSimulatedTimerThread.joinable() && gSimulatedTimerThread.get_id() != std::this_thread::get_id())
+    gSimulatedTimerThread.join();
+}
+
+void simulatedTimerStart(unsigned long iPeriodUs, anyrtttl::TimerCallbackFuncPtr iCallback) {
+  simulatedTimerStop();
+  if (gSimulatedTimerThread.joinable())
+    gSimulatedTimerThread.join();
+
+  gSimulatedTimerRunning = true;
+  gSimulatedTimerThread = std::thread([iPeriodUs, iCallback]() {
+    while (gSimulatedTimerRunning) {
+      std::this_thread::sleep_for(std::chrono::microseconds(iPeriodUs));
+      if (gSimulatedTimerRunning)
+        iCallback();
+    }
+  });
+}
+
+TestResult testTimerEngine() {
+  // play a melody with legacy non-blocking api as a reference
+  resetTestData();
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, simpsons);
+  while( !anyrtttl::nonblocking::done(c) )
+  {
+    anyrtttl::nonblocking::play(c);
+  }
+  std::string expected = removeTimestamps(gMelodyOutput);
+
+  // play the same melody from the simulated timer.
+  // The main thread does not call any AnyRtttl function while the melody is playing.
+  anyrtttl::timer::setTimerFunctions(&simulatedTimerStart, &simulatedTimerStop);
+  anyrtttl::timer::setPeriod(50);
+  resetTestData();
+  ASSERT_TRUE(anyrtttl::timer::begin(c, BUZZER_PIN, simpsons));
+  while( !anyrtttl::timer::done() )
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  anyrtttl::timer::stop();
+  std::string actual = removeTimestamps(gMelodyOutput);
+  testTracesAppend("actual=`%s`\n", actual.c_str());
+  ASSERT_STRING_EQ(expected.c_str(), actual.c_str());
+
+  // stop the melody before the end
+  resetTestData();
+  anyrtttl::nonblocking::beginBinary16(c, BUZZER_PIN, tetris16, sizeof(tetris16));
+  ASSERT_TRUE(anyrtttl::timer::play(c));
+  ASSERT_TRUE(anyrtttl::timer::isPlaying());
+  anyrtttl::timer::stop();
+  ASSERT_FALSE(anyrtttl::timer::isPlaying());
+  ASSERT_FALSE(anyrtttl::nonblocking::isPlaying(c));
+  ASSERT_FALSE(gSimulatedTimerRunning);
+
+  // a melody of another context replaces the melody of the timer
+  anyrtttl::rtttl_context_t c2 = {0};
+  anyrtttl::nonblocking::begin(c, BUZZER_PIN, simpsons);
+  ASSERT_TRUE(anyrtttl::timer::play(c));
+  anyrtttl::nonblocking::beginBinary16(c2, BUZZER_PIN, tetris16, sizeof(tetris16));
+  ASSERT_TRUE(anyrtttl::timer::play(c2));
+  ASSERT_TRUE(anyrtttl::nonblocking::done(c));
+  ASSERT_TRUE(anyrtttl::timer::isPlaying());
+  anyrtttl::timer::stop();
+  ASSERT_TRUE(anyrtttl::nonblocking::done(c2));
+
+  anyrtttl::timer::setTimerFunctions(NULL, NULL);
+  anyrtttl::timer::setPeriod(ANY_RTTTL_TIMER_PERIOD_US);
+
+  return TestResult::Pass;
+}
+#endif // __linux__
+
 void setup() {
   // Do not initialize the BUZZER_PIN pin.
   // because BUZZER_PIN is a fake pin number.
@@ -1432,6 +2727,29 @@ void setup() {
   TEST(testUpperCaseControlSectionAndMelody);
   TEST(testNonBlocking);
   TEST(testStop);
+  TEST(testCompiledMelody);
+  TEST(testPlayerReaderPolicies);
+  TEST(testBinaryMelody);
+  TEST(testBinaryEncoder);
+  TEST(testConstexprMelody);
+  TEST(testScheduler);
+  TEST(testMicrosTiming);
+  TEST(testMillisWraparound);
+  TEST(testBoundedParsing);
+  TEST(testSleep);
+  TEST(testOutput);
+  TEST(testChannelPool);
+  TEST(testSeek);
+  TEST(testPauseResume);
+  TEST(testLoop);
+  TEST(testCatalog);
+  TEST(testStream);
+  TEST(testWire);
+  TEST(testTelemetry);
+  TEST(testTrace);
+#if defined(__linux__)
+  TEST(testTimerEngine);
+#endif
 
   //TEST(testTetrisRamBlocking);
   //TEST(testProgramMemoryBlocking);
@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_fuzz: libFuzzer target of the RTTTL text parser.
+// Each input is played with a maximum length and compiled as a '\0' terminated melody.
+// The parsing mode is selected at compile time. The strict and relaxed
+// targets are built from this file. See CMakeLists.txt.
+//
+// Besides the memory errors found by the sanitizers, the target aborts when:
+//  - a byte outside of the input is read.
+//  - the parser reads more than READS_PER_BYTE bytes per input byte.
+//  - the melody does not end after one call to play() per input byte.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "anyrtttl.h"
+#include "rtttl_simulator.h"
+
+static const byte FUZZ_PIN = 8;
+
+// Budget of the parser. Each byte is read a few times: peeked, then read.
+static const size_t READS_PER_BYTE = 8;
+static const size_t READS_OVERHEAD = 16;
+
+static const char * gInputBegin = NULL;
+static const char * gInputEnd = NULL;
+static size_t gReads = 0;
+
+static char countingRead(const char * iBuffer)
+{
+  if (iBuffer < gInputBegin || iBuffer >= gInputEnd)
+  {
+    fprintf(stderr, "Read at offset %ld outside of the input of %ld bytes.\n", (long)(iBuffer - gInputBegin), (long)(gInputEnd - gInputBegin));
+    abort();
+  }
+  gReads++;
+  return *iBuffer;
+}
+
+static void setInput(const char * iBuffer, size_t iSize)
+{
+  gInputBegin = iBuffer;
+  gInputEnd = iBuffer + iSize;
+  gReads = 0;
+}
+
+static void checkBudget(const char * iName, size_t iSize)
+{
+  size_t budget = READS_PER_BYTE * iSize + READS_OVERHEAD;
+  if (gReads > budget)
+  {
+    fprintf(stderr, "%s read %lu bytes from an input of %lu bytes. The budget is %lu reads.\n", iName, (unsigned long)gReads, (unsigned long)iSize, (unsigned long)budget);
+    abort();
+  }
+}
+
+extern "C" int LLVMFuzzerInitialize(int * argc, char *** argv)
+{
+  anyrtttl::simulator::install();
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+{
+  // The input is not '\0' terminated. Reading past its end is detected by the sanitizers.
+  std::vector<char> melody(data, data + size);
+  const char * buffer = (size > 0 ? &melody[0] : NULL);
+
+  // play with a maximum length.
+  // Longer inputs cannot be bounded by a maximum length. They are compiled up to their '\0' below.
+  if (size < anyrtttl::RTTTL_UNBOUNDED_LENGTH)
+  {
+    setInput(buffer, size);
+    anyrtttl::simulator::reset();
+    anyrtttl::rtttl_context_t c = {0};
+    anyrtttl::nonblocking::begin(c, FUZZ_PIN, buffer, (uint16_t)size, &countingRead);
+    if (!anyrtttl::simulator::run(c, (uint32_t)size + 4))
+    {
+      fprintf(stderr, "The melody did not end after %lu calls to play().\n", (unsigned long)size + 4);
+      abort();
+    }
+    checkBudget("play()", size);
+  }
+
+  // compile as a '\0' terminated melody
+  melody.push_back('\0');
+  setInput(&melody[0], melody.size());
+  uint16_t count = anyrtttl::compile(&melody[0], &countingRead, NULL, 0);
+  checkBudget("compile()", size);
+  if (count > size)
+  {
+    fprintf(stderr, "compile() returned %u notes from an input of %lu bytes.\n", (unsigned)count, (unsigned long)size);
+    abort();
+  }
+
+  return 0;
+}
@@ -7,6 +7,7 @@
 
 #include "Arduino.h"
 #include "anyrtttl.h"
+#include "binrtttl.h"
 
 /*********************************************************
  * RTTTL Library data
@@ -24,87 +25,33 @@ NOTE_C7, NOTE_CS7, NOTE_D7, NOTE_DS7, NOTE_E7, NOTE_F7, NOTE_FS7, NOTE_G7, NOTE_
 
 static const byte NOTES_PER_OCTAVE = 12;
 
+// Character info of all ASCII characters. See character_class_t.
+#define CHAR_INFO(cls, value) (byte)((RTTTL_CHAR_##cls << 4) | (value))
+const byte gCharacterInfos[gCharacterInfosCount] PROGMEM = {
+  CHAR_INFO(END,0), 0, 0, 0, 0, 0, 0, 0, // 0x00
+  0, CHAR_INFO(SPACE,0), CHAR_INFO(SPACE,0), 0, 0, CHAR_INFO(SPACE,0), 0, 0, // 0x08
+  0, 0, 0, 0, 0, 0, 0, 0, // 0x10
+  0, 0, 0, 0, 0, 0, 0, 0, // 0x18
+  CHAR_INFO(SPACE,0), 0, 0, CHAR_INFO(SHARP,0), 0, 0, 0, 0, // 0x20
+  0, 0, 0, 0, CHAR_INFO(SEPARATOR,0), 0, CHAR_INFO(DOT,0), 0, // 0x28
+  CHAR_INFO(DIGIT,0), CHAR_INFO(DIGIT,1), CHAR_INFO(DIGIT,2), CHAR_INFO(DIGIT,3), CHAR_INFO(OCTAVE,4), CHAR_INFO(OCTAVE,5), CHAR_INFO(OCTAVE,6), CHAR_INFO(OCTAVE,7), // 0x30
+  CHAR_INFO(DIGIT,8), CHAR_INFO(DIGIT,9), CHAR_INFO(SECTION,0), 0, 0, CHAR_INFO(EQUAL,0), 0, 0, // 0x38
+  0, CHAR_INFO(NOTE,5), CHAR_INFO(NOTE,6), CHAR_INFO(NOTE,0), CHAR_INFO(NOTE,1), CHAR_INFO(NOTE,2), CHAR_INFO(NOTE,3), CHAR_INFO(NOTE,4), // 0x40
+  0, 0, 0, 0, 0, 0, 0, 0, // 0x48
+  CHAR_INFO(NOTE,7), 0, 0, 0, 0, 0, 0, 0, // 0x50
+  0, 0, 0, 0, 0, 0, 0, 0, // 0x58
+  0, CHAR_INFO(NOTE,5), CHAR_INFO(NOTE,6), CHAR_INFO(NOTE,0), CHAR_INFO(NOTE,1), CHAR_INFO(NOTE,2), CHAR_INFO(NOTE,3), CHAR_INFO(NOTE,4), // 0x60
+  0, 0, 0, 0, 0, 0, 0, 0, // 0x68
+  CHAR_INFO(NOTE,7), 0, 0, 0, 0, 0, 0, 0, // 0x70
+  0, 0, 0, 0, 0, 0, 0, 0 // 0x78
+};
+#undef CHAR_INFO
+
 // Define a global context for supporting legacy api functions.
 // Legacy api functions did not required an rtttl_context_t as first parameter to play a melody.
 // All legacy functions uses this default context as the first parameter for newer apis.
 rtttl_context_t gGlobalContext = {0};
 
-inline __attribute__((always_inline)) bool isDigitCharacter(char c) {
-  return (c >= '0' && c <= '9');
-}
-
-inline __attribute__((always_inline)) bool isUpperCaseCharacter(char c) {
-  return (c >= 'A' && c <= 'Z');
-}
-
-inline __attribute__((always_inline)) char peekChar(rtttl_context_t & c)
-{
-  char character = c.getCharPtr(c.next);
-  return character;
-}
-
-inline __attribute__((always_inline)) char readChar(rtttl_context_t & c)
-{
-  char character = c.getCharPtr(c.next);
-  c.next++;
-  return character;
-}
-
-inline __attribute__((always_inline)) char readLowerCaseChar(rtttl_context_t & c)
-{
-  char character = readChar(c);
-
-  // Support uppercase characters in melody
-  if (isUpperCaseCharacter(character)) {
-    character = (character - 'A' + 'a');
-  }
-
-  return character;
-}
-
-inline __attribute__((always_inline)) void skipCharacters(rtttl_context_t & c, char character)
-{
-    while(peekChar(c) == character)
-      c.next++; // ignore white space
-}
-
-inline __attribute__((always_inline)) void skipWhiteSpace(rtttl_context_t & c)
-{
-  skipCharacters(c, ' ');
-}
-
-int readInteger(rtttl_context_t & c)
-{
-  int value = 0;
-
-  // read first character
-  char character = peekChar(c); // peek only at the next character
-  while(isDigitCharacter(character))
-  {
-    character = readChar(c); // actually move the read offset
-    value = (value * 10) + (character - '0');
-
-    // read next character
-    character = peekChar(c); // peek only at the next character
-  }
-
-  return value;
-}
-
-#ifdef ANY_RTTTL_DEBUG
-void serialPrint(rtttl_context_t & c)
-{
-  // read first character
-  char character = readChar(c);
-  while(character) {
-    Serial.print(character);
-
-    // read next character
-    character = readChar(c);
-  }
-}
-#endif
-
 /****************************************************************************
  * Custom functions
  ****************************************************************************/
@@ -113,16 +60,23 @@ void serialPrint(rtttl_context_t & c)
   ToneFuncPtr _tone = NULL;
   NoToneFuncPtr _noTone = NULL;
   MillisFuncPtr _millis = NULL;
+  MicrosFuncPtr _micros = NULL;
 #elif defined(ANY_RTTTL_DONT_USE_TONE_LIB)
   ToneFuncPtr _tone = NULL;
   NoToneFuncPtr _noTone = NULL;
   MillisFuncPtr _millis = &millis;
+  MicrosFuncPtr _micros = &micros;
 #else
   ToneFuncPtr _tone = &tone;
   NoToneFuncPtr _noTone = &noTone;
   MillisFuncPtr _millis = &millis;
+  MicrosFuncPtr _micros = &micros;
 #endif
 
+SleepFuncPtr _sleep = NULL;
+
+byte gTimingMode = RTTTL_TIMING_MILLIS;
+
 void setToneFunction(ToneFuncPtr iFunc) {
   _tone = iFunc;
 }
@@ -135,6 +89,22 @@ void setMillisFunction(MillisFuncPtr iFunc) {
   _millis = iFunc;
 }
 
+void setMicrosFunction(MicrosFuncPtr iFunc) {
+  _micros = iFunc;
+}
+
+void setSleepFunction(SleepFuncPtr iFunc) {
+  _sleep = iFunc;
+}
+
+void setTimingMode(byte iMode) {
+  gTimingMode = iMode;
+}
+
+byte getTimingMode() {
+  return gTimingMode;
+}
+
 char readCharMem(const char * iBuffer) {
   char output = *iBuffer;
   return output;
@@ -145,6 +115,189 @@ char readCharPgm(const char * iBuffer) {
   return output;
 }
 
+namespace detail
+{
+
+bool beginContext(rtttl_context_t & c, const rtttl_output_t * iOutput)
+{
+  initContext(c);
+  c.tone = (iOutput != NULL ? iOutput->tone : _tone);
+  c.noTone = (iOutput != NULL ? iOutput->noTone : _noTone);
+  return isFunctionsAssigned(c);
+}
+
+uint16_t getNoteFrequency(octave_value_t iScale, byte iNoteOffset)
+{
+  // Notes outside of the table (invalid octave, B# of the last octave, repeated sharps) are played as a pause.
+  uint16_t index = (uint16_t)(iScale - 4) * NOTES_PER_OCTAVE + iNoteOffset;
+  if (iNoteOffset == 0 || iScale < 4 || index >= sizeof(gNotes)/sizeof(gNotes[0]))
+    return NOTE_SILENT;
+  return gNotes[index];
+}
+
+// Length of a whole note at 1 bpm in microseconds (4 beats of 60 seconds).
+static const uint32_t WHOLE_NOTE_LENGTH_US = 240000000UL;
+
+// Maximum number of dots of a note length in microseconds.
+// A whole note with 7 dots is 4,100,625,000 us at 1 bpm, the longest length that fits in 32 bits.
+static const byte MAX_NOTE_DOTS_US = 7;
+
+/****************************************************************************
+ * Description:
+ *   Returns the length of the current note in microseconds.
+ *   The length is computed in 1/bpm microseconds which is exact for all
+ *   power of 2 durations. The remaining fraction of microsecond is carried
+ *   to the next note so that rounding errors do not accumulate.
+ ****************************************************************************/
+static unsigned long getNoteLengthUs(rtttl_context_t & c, duration_value_t iDuration)
+{
+  if (c.noteDivisor == 0 || c.bpm == 0)
+    return (unsigned long)iDuration * 1000; // precompiled notes are only known in milliseconds
+
+  // saturate the number of dots to prevent an overflow. Such notes are never valid.
+  byte dots = (c.noteDots < MAX_NOTE_DOTS_US ? c.noteDots : MAX_NOTE_DOTS_US);
+  uint32_t length = WHOLE_NOTE_LENGTH_US / c.noteDivisor;
+  for(byte i=0; i<dots; i++)
+    length += length/2;
+
+  length += c.tempoRemainder;
+  c.tempoRemainder = (uint16_t)(length % c.bpm);
+  return length / c.bpm;
+}
+
+void playTone(rtttl_context_t & c, uint16_t iFrequency, duration_value_t iDuration)
+{
+  #ifdef ANY_RTTTL_TELEMETRY
+  recordNoteStart(c);
+  #endif
+  RTTTL_TRACE(c, RTTTL_TRACE_NOTE_START, iFrequency);
+
+  //stop previous playing note, if any.
+  //A tone replaces the previous note without a silence in between,
+  //which lets an output skip writing a frequency that did not change.
+  if (iFrequency == NOTE_SILENT)
+    c.noTone(c.pin);
+
+  if (gTimingMode == RTTTL_TIMING_MICROS)
+  {
+    if (iFrequency != NOTE_SILENT)
+      c.tone(c.pin, iFrequency, iDuration);
+
+    // schedule the next note from the end of the previous note
+    unsigned long start = (c.hasDeadline ? c.nextNoteUs : _micros());
+    c.nextNoteUs = start + getNoteLengthUs(c, iDuration);
+    c.hasDeadline = true;
+    return;
+  }
+
+  if (iFrequency != NOTE_SILENT)
+  {
+    c.tone(c.pin, iFrequency, iDuration);
+
+    c.nextNoteMs = _millis() + (iDuration+1);
+  }
+  else
+  {
+    c.nextNoteMs = _millis() + (iDuration);
+  }
+}
+
+/****************************************************************************
+ * Description:
+ *   Reads the raw bits of the next note of a binary RTTTL melody.
+ *   Notes encoded with 10 bits may span over 2 bytes. The note is always
+ *   read with 2 consecutive bytes which never exceeds the end of the buffer.
+ ****************************************************************************/
+static RTTTL_NOTE readBinaryNote(rtttl_context_t & c)
+{
+  RTTTL_NOTE note;
+  if (c.format == RTTTL_FORMAT_BINARY16)
+  {
+    const char * p = c.buffer + c.noteIndex * sizeof(RTTTL_NOTE);
+    note.raw = (byte)c.getCharPtr(p) | ((byte)c.getCharPtr(p+1) << 8);
+  }
+  else
+  {
+    uint32_t bitOffset = (uint32_t)c.noteIndex * RTTTL_NOTE_SIZE_BITS;
+    const char * p = c.buffer + (bitOffset >> 3);
+    uint16_t bits = (byte)c.getCharPtr(p) | ((byte)c.getCharPtr(p+1) << 8);
+    note.raw = (bits >> (bitOffset & 0x07)) & ((1 << RTTTL_NOTE_SIZE_BITS) - 1);
+  }
+  return note;
+}
+
+void decodeBinaryNote(rtttl_context_t & c)
+{
+  RTTTL_NOTE note = readBinaryNote(c);
+
+  duration_value_t d = getDurationValueFromIndex(note.durationIdx);
+  if (isValidDuration(d))
+    c.duration = c.wholeNote / d;
+  else
+    c.duration = c.wholeNote / c.melodyDefaultDur;  // we will need to check if we are a dotted note after
+
+  c.noteDivisor = (isValidDuration(d) ? d : c.melodyDefaultDur);
+  c.noteDots = note.dotted;
+  if (note.dotted)
+    c.duration += c.duration/2;
+
+  c.noteOffset = getNoteOffsetFromNoteIndex(note.noteIdx) + (note.pound ? 1 : 0);
+  c.scale = getOctaveValueFromIndex(note.octaveIdx);
+}
+
+/****************************************************************************
+ * Description:
+ *   Decodes and plays the next note of a binary RTTTL melody.
+ *   Produces the same duration and frequency as the equivalent text note.
+ ****************************************************************************/
+static void playBinaryNote(rtttl_context_t & c)
+{
+  #ifdef ANY_RTTTL_TELEMETRY
+  unsigned long parseStart = getParseTime();
+  decodeBinaryNote(c);
+  recordParseTime(c, parseStart);
+  #else
+  decodeBinaryNote(c);
+  #endif
+  playTone(c, getNoteFrequency(c.scale, c.noteOffset), c.duration);
+}
+
+}; //detail namespace
+
+uint16_t compile(const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, rtttl_note_event_t * oEvents, uint16_t iMaxEvents)
+{
+  // Use a private context for parsing the melody.
+  // The melody is never played.
+  rtttl_context_t c;
+  initContext(c);
+  c.buffer = iBuffer;
+  c.next = iBuffer;
+
+  function_reader r = { iGetCharFuncPtr };
+  if (!detail::readControlSection(c, r))
+    return 0;
+
+  uint16_t count = 0;
+  while (detail::peekChar(c, r) != '\0')
+  {
+    detail::readNote(c, r);
+
+    if (oEvents != NULL)
+    {
+      if (count >= iMaxEvents)
+        break; // output buffer is full
+
+      rtttl_note_event_t & e = oEvents[count];
+      e.frequency = detail::getNoteFrequency(c.scale, c.noteOffset);
+      e.duration = c.duration;
+    }
+
+    count++;
+  }
+
+  return count;
+}
+
 
 
 /****************************************************************************
@@ -153,6 +306,21 @@ char readCharPgm(const char * iBuffer) {
 namespace blocking
 {
 
+// Waits until the next call to nonblocking::play().
+static void waitForNextEvent(rtttl_context_t & c)
+{
+  if (_sleep != NULL)
+  {
+    unsigned long remaining = anyrtttl::nonblocking::millisUntilNextEvent(c);
+    if (remaining != RTTTL_NO_EVENT && remaining > 0)
+    {
+      _sleep(remaining);
+      return;
+    }
+  }
+  yield(); // prevent watchdog to reset the board.
+}
+
 void play(rtttl_context_t & c, byte iPin, const char* iBuffer, GetCharFuncPtr iGetCharFuncPtr) {
   // Implement blocking code using the non-blocking apis.
 
@@ -163,7 +331,43 @@ void play(rtttl_context_t & c, byte iPin, const char* iBuffer, GetCharFuncPtr iG
   while( !anyrtttl::nonblocking::done(c) ) 
   {
     anyrtttl::nonblocking::play(c);
-    yield(); // prevent watchdog to reset the board.
+    waitForNextEvent(c);
+  }
+}
+
+void play(rtttl_context_t & c, byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount) {
+  // Init the context for playing this melody
+  anyrtttl::nonblocking::begin(c, iPin, iEvents, iEventsCount);
+  
+  // Loop until the melody has played
+  while( !anyrtttl::nonblocking::done(c) ) 
+  {
+    anyrtttl::nonblocking::play(c);
+    waitForNextEvent(c);
+  }
+}
+
+void playBinary10(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr) {
+  // Init the context for playing this melody
+  anyrtttl::nonblocking::beginBinary10(c, iPin, iBuffer, iSize, iGetCharFuncPtr);
+  
+  // Loop until the melody has played
+  while( !anyrtttl::nonblocking::done(c) ) 
+  {
+    anyrtttl::nonblocking::play(c);
+    waitForNextEvent(c);
+  }
+}
+
+void playBinary16(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr) {
+  // Init the context for playing this melody
+  anyrtttl::nonblocking::beginBinary16(c, iPin, iBuffer, iSize, iGetCharFuncPtr);
+  
+  // Loop until the melody has played
+  while( !anyrtttl::nonblocking::done(c) ) 
+  {
+    anyrtttl::nonblocking::play(c);
+    waitForNextEvent(c);
   }
 }
 
@@ -178,352 +382,249 @@ void play(rtttl_context_t & c, byte iPin, const char* iBuffer, GetCharFuncPtr iG
 namespace nonblocking
 {
 
+void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput)
+{
+  begin(c, iPin, iBuffer, RTTTL_UNBOUNDED_LENGTH, iGetCharFuncPtr, iOutput);
+}
 
-//pre-declaration
-void nextNote();
-void nextNote(rtttl_context_t & c);
+void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, uint16_t iMaxLength, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput)
+{
+  function_reader r = { iGetCharFuncPtr };
+  detail::begin(c, r, iPin, iBuffer, iMaxLength, iOutput);
+  c.getCharPtr = iGetCharFuncPtr;
+}
 
-void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr)
+void begin(rtttl_context_t & c, byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount, const rtttl_output_t * iOutput)
 {
-  // Check uninitialized _tone(), _noTone() or _millis() function pointers.
-  if (_tone == NULL || _noTone == NULL || _millis == NULL) {
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println(F( "AnyRtttl initialization incomplete!\n"
-                      "No function defined for _tone(), _noTone() or _millis().\n"
-                      "Use anyrtttl::setToneFunction(), anyrtttl::setNoToneFunction() or anyrtttl::setMillisFunction() to assign custom functions."));
-    #endif
+  // init context
+  if (!detail::beginContext(c, iOutput))
     return;
-  }
 
+  //init values
+  c.pin = iPin;
+  c.format = RTTTL_FORMAT_EVENTS;
+  c.events = iEvents;
+  c.notesCount = iEventsCount;
+  c.noteIndex = 0;
+  c.playing = true;
+  RTTTL_TRACE(c, RTTTL_TRACE_BEGIN, c.format);
+
+  //stop current note
+  c.noTone(c.pin);
+}
+
+static void beginBinary(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput, byte iFormat)
+{
   // init context
-  initContext(c);
+  if (!detail::beginContext(c, iOutput))
+    return;
 
   //init values
   c.pin = iPin;
-  c.melodyDefaultDur = RTTTL_DEFAULT_DURATION_VALUE;
-  c.melodyDefaultOct = RTTTL_DEFAULT_OCTAVE_VALUE;
-  c.bpm=RTTTL_DEFAULT_BPM_VALUE;
-  c.buffer = iBuffer;
-  c.next = iBuffer;
+  c.format = iFormat;
   c.getCharPtr = iGetCharFuncPtr;
   c.playing = true;
-
-  int number = 0;
- 
-  #ifdef ANY_RTTTL_DEBUG
-  Serial.print("playing: ");
-  serialPrint(c);
-  Serial.println();
-  #endif
+  RTTTL_TRACE(c, RTTTL_TRACE_BEGIN, c.format);
 
   //stop current note
-  _noTone(c.pin);
-
-  // format: d=N,o=N,b=NNN:
-  // find the start (skip name, etc)
-
-  // skip melody name
-  while(peekChar(c) != ':') c.next++; // ignore name
-  c.next++;                           // skip ':'
+  c.noTone(c.pin);
 
-  #if defined(RTTTL_PARSER_STRICT)
-    // get default duration
-    if(peekChar(c) == 'd')
-    {
-      c.next += 2;                      // skip "d="
-      number = readInteger(c);
-      if(isValidDuration((duration_value_t)number))
-        c.melodyDefaultDur = number;
-      c.next++;                         // skip comma
-    }
-    
-    // get default octave
-    if(peekChar(c) == 'o')
-    {
-      c.next += 2;                      // skip "o="
-      number = readInteger(c);
-      if(isValidOctave((octave_value_t)number))
-        c.melodyDefaultOct = number;
-      c.next++;                         // skip comma
-    }
-    
-    // get BPM
-    if(peekChar(c) == 'b')
-    {
-      c.next += 2;                      // skip "b="
-      number = readInteger(c);
-      c.bpm = number;
-      c.next++;                         // skip colon
-    }
-  #elif defined(RTTTL_PARSER_RELAXED)
-    char character = readLowerCaseChar(c);
-
-    while(character != ':') { // read until the end of control section.
-      switch(character) {
-        case 'd': {
-          // get default duration
-          c.next++;                         // skip "="
-          number = readInteger(c);
-          if(isValidDuration((duration_value_t)number))
-            c.melodyDefaultDur = number;
-        }
-        break;
-        case 'o': {
-          // get default octave
-          c.next++;                         // skip "="
-          number = readInteger(c);
-          if(isValidOctave((octave_value_t)number))
-            c.melodyDefaultOct = number;
-        }
-        break;
-        case 'b': {
-          // get BPM
-          c.next++;                         // skip "="
-          number = readInteger(c);
-          c.bpm = number;
-        }
-        break;
-        case '\0': {
-          // Parsing error: unexpected end of control section
-          stop(c);
-          return;
-        }
-        break;
-      }
-
-      // read next
-      character = readLowerCaseChar(c);
-    }
-  #endif // RTTTL_PARSER_STRICT / RTTTL_PARSER_RELAXED
+  if (iBuffer == NULL || iSize < sizeof(RTTTL_CONTROL_SECTION))
+  {
+    c.playing = false;
+    return;
+  }
 
-  #ifdef ANY_RTTTL_INFO
-  Serial.print("ddur: "); Serial.println(c.melodyDefaultDur, 10);
-  Serial.print("doct: "); Serial.println(c.melodyDefaultOct, 10);
-  Serial.print("bpm: "); Serial.println(c.bpm, 10);
-  #endif
+  //read the control section
+  const char * p = (const char *)iBuffer;
+  RTTTL_CONTROL_SECTION ctrl;
+  ctrl.raw = (byte)c.getCharPtr(p) | ((byte)c.getCharPtr(p+1) << 8);
+
+  duration_value_t d = getDurationValueFromIndex(ctrl.durationIdx);
+  if (isValidDuration(d))
+    c.melodyDefaultDur = d;
+  c.melodyDefaultOct = getOctaveValueFromIndex(ctrl.octaveIdx);
+  c.bpm = ctrl.bpm;
+  if (c.bpm == 0)
+  {
+    // invalid melody
+    c.playing = false;
+    return;
+  }
 
   // BPM usually expresses the number of quarter notes per minute
   c.wholeNote = (60 * 1000L / c.bpm) * 4;  // this is the time for whole note (in milliseconds)
 
-  #ifdef ANY_RTTTL_INFO
-  Serial.print("wn: "); Serial.println(c.wholeNote, 10);
-  #endif
+  //notes are stored right after the control section
+  c.buffer = p + sizeof(RTTTL_CONTROL_SECTION);
+  c.next = c.buffer;
+  uint16_t notesSize = iSize - sizeof(RTTTL_CONTROL_SECTION);
+  if (iFormat == RTTTL_FORMAT_BINARY16)
+    c.notesCount = notesSize / sizeof(RTTTL_NOTE);
+  else
+    c.notesCount = (uint16_t)(((uint32_t)notesSize * 8) / RTTTL_NOTE_SIZE_BITS);
+  c.noteIndex = 0;
 }
 
-void nextNote(rtttl_context_t & c)
+void beginBinary10(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput)
 {
-  int number = 0;
-
-  //stop previous playing note, if any
-  _noTone(c.pin);
-
-  // Set default values
-  c.duration = c.wholeNote / c.melodyDefaultDur;  // we will check if we are a dotted note later
-  c.scale = c.melodyDefaultOct; // default scale, if unspecified
-  c.noteOffset = 0; // default note is a pause/silence note, if unspecified
-
-  #if defined(RTTTL_PARSER_STRICT)
-    // get note duration, if available
-    number = readInteger(c);
-    if(isValidDuration((duration_value_t)number))
-      c.duration = c.wholeNote / number;
-
-    // now get the note
-    c.noteOffset = findNoteOffsetFromNoteValue(peekChar(c));
-    c.next++;                           // skip note letter
-
-    // now, get optional '#' sharp
-    if(peekChar(c) == '#')
-    {
-      c.noteOffset++;
-      c.next++;                         // skip '#'
-    }
-
-    // now, get optional '.' dotted note (Nokia's Simpsons example)
-    if(peekChar(c) == '.')
-    {
-      c.duration += c.duration/2;
-      c.next++;                         // skip '.'
-    }
-
-    // now, get scale
-    if(isdigit(peekChar(c)))
-    {
-      c.scale = peekChar(c) - '0';
-      c.next++;                         // skip scale
-    }
-    else
-    {
-      c.scale = c.melodyDefaultOct;
-    }
-
-    // now, get optional '.' dotted note (Nokia's original specification)
-    if(peekChar(c) == '.')
-    {
-      c.duration += c.duration/2;
-      c.next++;                         // skip '.'
-    }
-
-    if(peekChar(c) == ',')
-      c.next++;                         // skip comma for next note (or we may be at the end)
-  #elif defined(RTTTL_PARSER_RELAXED)
-    skipWhiteSpace(c);
-
-    // get note duration, if available
-    number = readInteger(c);
-    if(isValidDuration((duration_value_t)number))
-      c.duration = c.wholeNote / number;
-    
-    // Parse note characters 1 by 1, until note separator or end of buffer
-    while (peekChar(c) != '\0') {
-      char character = readLowerCaseChar(c);
-
-      if(character == '#')
-      {
-        // optional '#' sharp
-        c.noteOffset++;
-      }
-      else if(character == '.')
-      {
-        // optional '.' dotted note
-        c.duration += c.duration/2;
-      }
-      else if(isValidOctave(character))
-      {
-        // scale
-        c.scale = (character - '0');
-      }
-      else if (isValidNoteValue(character))
-      {
-        // now get the note
-        c.noteOffset = findNoteOffsetFromNoteValue(character);
-      }
-      else if(character == ',')
-      {
-        // end of note
-        break;
-      }
-      else {
-        // unknown character
-      }
-    }
-  #endif // RTTTL_PARSER_STRICT / RTTTL_PARSER_RELAXED
+  beginBinary(c, iPin, iBuffer, iSize, iGetCharFuncPtr, iOutput, RTTTL_FORMAT_BINARY10);
+}
 
-  // now play the note
-  if(c.noteOffset)
-  {
-    #ifdef ANY_RTTTL_INFO
-    Serial.print("Playing: ");
-    Serial.print(c.scale, 10); Serial.print(' ');
-    Serial.print(c.noteOffset, 10); Serial.print(" (");
-    Serial.print(gNotes[(c.scale - 4) * NOTES_PER_OCTAVE + c.noteOffset], 10);
-    Serial.print(") ");
-    Serial.println(c.duration, 10);
-    #endif
- 
-    uint16_t frequency = gNotes[(c.scale - 4) * NOTES_PER_OCTAVE + c.noteOffset];
-    _tone(c.pin, frequency, c.duration);
-    
-    c.nextNoteMs = _millis() + (c.duration+1);
-  }
-  else
-  {
-    #ifdef ANY_RTTTL_INFO
-    Serial.print("Pausing: ");
-    Serial.println(duration, 10);
-    #endif
-    
-    c.nextNoteMs = _millis() + (c.duration);
-  }
+void beginBinary16(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput)
+{
+  beginBinary(c, iPin, iBuffer, iSize, iGetCharFuncPtr, iOutput, RTTTL_FORMAT_BINARY16);
 }
 
 void play(rtttl_context_t & c)
 {
-  // Check uninitialized _tone(), _noTone() or _millis() function pointers.
-  if (_tone == NULL || _noTone == NULL || _millis == NULL) {
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println(F( "AnyRtttl initialization incomplete!\n"
-                      "No function defined for _tone(), _noTone() or _millis().\n"
-                      "Use anyrtttl::setToneFunction(), anyrtttl::setNoToneFunction() or anyrtttl::setMillisFunction() to assign custom functions."));
-    #endif
+  if (c.format == RTTTL_FORMAT_TEXT)
+  {
+    // RTTTL text melody
+    function_reader r = { c.getCharPtr };
+    detail::play(c, r);
     return;
   }
 
+  // Precompiled or binary melody
   //if done playing the song, return
   if (!c.playing)
-  {
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println("done playing...");
-    #endif
-    
     return;
-  }
+
+  //if the song is paused, wait until resume()
+  if (c.paused)
+    return;
+
+  #ifdef ANY_RTTTL_TELEMETRY
+  detail::recordPoll(c);
+  #endif
   
   //are we still playing a note ?
-  unsigned long m = _millis();
-  if (m < c.nextNoteMs)
-  {
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println("still playing a note...");
-    #endif
-    
-    //wait until the note is completed
-    return;
-  }
+  if (detail::isTimeBefore(detail::getTime(), detail::getNextNoteTime(c)))
+    return; //wait until the note is completed
 
   //ready to play the next note
-  if (peekChar(c) == '\0')
+  bool end = (c.noteIndex >= c.notesCount);
+  if (c.format == RTTTL_FORMAT_STREAM)
+  {
+    if (detail::waitStreamNote(c))
+      return; //wait until the next note is received
+    end = (stream::available(*c.stream) == 0);
+  }
+  RTTTL_TRACE_NOTE_END(c);
+  if (detail::loopBack(c, end))
+    end = false;
+  if (end)
   {
     //no more notes. Reached the end of the last note
-
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println("end of note...");
-    #endif
-    
     c.playing = false;
+    RTTTL_TRACE(c, RTTTL_TRACE_END, c.noteIndex);
 
     //stop current note (if any)
-    _noTone(c.pin);
+    c.noTone(c.pin);
 
     return; //end of the song
   }
+
+  //more notes to play...
+  if (c.format == RTTTL_FORMAT_EVENTS)
+  {
+    const rtttl_note_event_t & e = c.events[c.noteIndex];
+    detail::playTone(c, e.frequency, e.duration);
+  }
+  else if (c.format == RTTTL_FORMAT_STREAM)
+  {
+    detail::playStreamNote(c);
+  }
   else
   {
-    //more notes to play...
-
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println("next note...");
-    #endif
-    
-    nextNote(c);
+    detail::playBinaryNote(c);
   }
+  c.noteIndex++;
 }
 
 void stop(rtttl_context_t & c)
 {
-  // Check uninitialized _tone(), _noTone() or _millis() function pointers.
-  if (_tone == NULL || _noTone == NULL || _millis == NULL) {
-    #ifdef ANY_RTTTL_DEBUG
-    Serial.println(F( "AnyRtttl initialization incomplete!\n"
-                      "No function defined for _tone(), _noTone() or _millis().\n"
-                      "Use anyrtttl::setToneFunction(), anyrtttl::setNoToneFunction() or anyrtttl::setMillisFunction() to assign custom functions."));
-    #endif
+  if (c.format == RTTTL_FORMAT_TEXT)
+  {
+    // RTTTL text melody
+    detail::stop(c);
     return;
   }
 
-  if (c.playing)
+  // Precompiled or binary melody
+  //skip all remaining notes
+  RTTTL_TRACE(c, RTTTL_TRACE_STOP, c.noteIndex);
+  c.noteIndex = c.notesCount;
+  c.playing = false;
+  c.paused = false;
+
+  //stop current note (if any)
+  if (c.noTone != NULL)
+    c.noTone(c.pin);
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns the frequency of the last note played by the given context.
+ ****************************************************************************/
+static uint16_t getCurrentFrequency(const rtttl_context_t & c)
+{
+  if (c.format == RTTTL_FORMAT_EVENTS)
+    return (c.noteIndex > 0 ? c.events[c.noteIndex-1].frequency : NOTE_SILENT);
+  return detail::getNoteFrequency(c.scale, c.noteOffset);
+}
+
+void pause(rtttl_context_t & c)
+{
+  if (!c.playing || c.paused)
+    return;
+
+  //keep the time left of the current note
+  unsigned long now = detail::getTime();
+  unsigned long end = detail::getNextNoteTime(c);
+  c.remainingTime = (detail::isTimeBefore(now, end) ? end - now : 0);
+  c.paused = true;
+  RTTTL_TRACE(c, RTTTL_TRACE_PAUSE, c.noteIndex);
+
+  //stop current note (if any)
+  c.noTone(c.pin);
+}
+
+void resume(rtttl_context_t & c)
+{
+  if (!c.playing || !c.paused)
+    return;
+  c.paused = false;
+
+  #ifdef ANY_RTTTL_TELEMETRY
+  c.telemetry.polled = false; // the pause is not a gap between polls
+  #endif
+  RTTTL_TRACE(c, RTTTL_TRACE_RESUME, c.noteIndex);
+
+  //the next note starts after the time left of the current note
+  unsigned long now = detail::getTime();
+  unsigned long toneMs;
+  if (gTimingMode == RTTTL_TIMING_MICROS)
   {
-    //increase song buffer until the end
-    while (peekChar(c) != '\0')
-    {
-      c.next++;
-    }
+    c.nextNoteUs = now + c.remainingTime;
+    toneMs = c.remainingTime / 1000;
+  }
+  else
+  {
+    c.nextNoteMs = now + c.remainingTime;
+    toneMs = (c.remainingTime > 0 ? c.remainingTime - 1 : 0); // tones are followed by 1 ms of silence. See playTone().
   }
 
-  c.playing = false;
+  //play the rest of the current note
+  uint16_t frequency = getCurrentFrequency(c);
+  if (frequency != NOTE_SILENT && toneMs > 0)
+    c.tone(c.pin, frequency, toneMs);
+}
 
-  //stop current note (if any)
-  _noTone(c.pin);
+bool isPaused(rtttl_context_t & c)
+{
+  return c.paused;
 }
 
 bool done(rtttl_context_t & c)
@@ -536,12 +637,30 @@ bool isPlaying(rtttl_context_t & c)
   return c.playing;
 }
 
+unsigned long millisUntilNextEvent(const rtttl_context_t & c)
+{
+  if (!c.playing || c.paused)
+    return RTTTL_NO_EVENT;
+
+  unsigned long now = detail::getTime();
+  unsigned long next = detail::getNextNoteTime(c);
+  if (!detail::isTimeBefore(now, next))
+    return 0; // the current note is done
+
+  unsigned long remaining = next - now;
+  if (gTimingMode == RTTTL_TIMING_MICROS)
+    remaining /= 1000; // never sleep past the end of the note
+  return remaining;
+}
+
 }; //nonblocking namespace
 
 void initContext(rtttl_context_t & c) {
   c.pin = -1;
+  c.format = RTTTL_FORMAT_TEXT;
   c.buffer = NULL;
   c.next = NULL;
+  c.maxLength = RTTTL_UNBOUNDED_LENGTH;
   c.getCharPtr = &readCharMem;
   c.melodyDefaultDur = RTTTL_DEFAULT_DURATION_VALUE;
   c.melodyDefaultOct = RTTTL_DEFAULT_OCTAVE_VALUE;
@@ -552,6 +671,26 @@ void initContext(rtttl_context_t & c) {
   c.nextNoteMs = 0;
   c.playing = false;
   c.noteOffset = 0;
+  c.events = NULL;
+  c.notesCount = 0;
+  c.noteIndex = 0;
+  c.noteDivisor = 0;
+  c.noteDots = 0;
+  c.hasDeadline = false;
+  c.nextNoteUs = 0;
+  c.tempoRemainder = 0;
+  c.paused = false;
+  c.remainingTime = 0;
+  c.loopStartOffset = 0;
+  c.loopStartNote = 0;
+  c.loopEndNote = RTTTL_LOOP_END;
+  c.loopCount = 0;
+  c.stream = NULL;
+  c.tone = NULL;
+  c.noTone = NULL;
+#ifdef ANY_RTTTL_TELEMETRY
+  telemetry::reset(c);
+#endif
 }
 
 }; //anyrtttl namespace
@@ -30,13 +30,101 @@ namespace anyrtttl
  ****************************************************************************/
 typedef char (*GetCharFuncPtr)(const char * iBuffer);
 
+/****************************************************************************
+ * Description:
+ *   Defines a function pointer to a tone() function
+ ****************************************************************************/
+typedef void (*ToneFuncPtr)(uint8_t pin, unsigned int frequency, unsigned long duration);
+
+/****************************************************************************
+ * Description:
+ *   Defines a function pointer to a noTone() function
+ ****************************************************************************/
+typedef void (*NoToneFuncPtr)(uint8_t pin);
+
 /****************************************************************************
  * Structure definitions
  ****************************************************************************/
+
+/****************************************************************************
+ * Description:
+ *   Defines a precompiled note of an RTTTL melody.
+ *   See anyrtttl::compile() for building an array of notes from an RTTTL melody.
+ ****************************************************************************/
+typedef struct rtttl_note_event_t {
+  uint16_t frequency;         // frequency of the note in Hz. A frequency of NOTE_SILENT (0) is a pause.
+  duration_value_t duration;  // duration of the note in milliseconds.
+} rtttl_note_event_t;
+
+/****************************************************************************
+ * Description:
+ *   Defines the output of a melody: the functions that play its notes.
+ *   Each melody can play on its own output given to nonblocking::begin().
+ ****************************************************************************/
+typedef struct rtttl_output_t {
+  ToneFuncPtr tone;           // starts a tone on a pin.
+  NoToneFuncPtr noTone;       // stops the tone of a pin.
+} rtttl_output_t;
+
+/****************************************************************************
+ * Description:
+ *   Defines the format of the melody played by a context.
+ ****************************************************************************/
+enum rtttl_format_t {
+  RTTTL_FORMAT_TEXT = 0,      // an RTTTL text melody read with a GetCharFuncPtr function.
+  RTTTL_FORMAT_EVENTS,        // an array of precompiled notes. See anyrtttl::compile().
+  RTTTL_FORMAT_BINARY10,      // a binary RTTTL melody encoded with 10 bits per note. See BinaryRTTTL.md.
+  RTTTL_FORMAT_BINARY16,      // a binary RTTTL melody encoded with 16 bits per note. See BinaryRTTTL.md.
+  RTTTL_FORMAT_STREAM,        // an RTTTL text melody parsed as it is received. See rtttl_stream_t.
+};
+
+/****************************************************************************
+ * Description:
+ *   Defines the events of the trace buffer. See the trace namespace.
+ ****************************************************************************/
+enum rtttl_trace_event_t {
+  RTTTL_TRACE_BEGIN = 1,      // a melody begins. The value is the format of the melody. See rtttl_format_t.
+  RTTTL_TRACE_NOTE_START,     // a note starts. The value is the frequency of the note. 0 is a pause.
+  RTTTL_TRACE_NOTE_END,       // play() reached the end of a note. The value is the index of the note.
+  RTTTL_TRACE_LATE_POLL,      // play() reached the end of a note late. The value is the delay in the unit of the timing mode.
+  RTTTL_TRACE_END,            // the melody is done. The value is the number of notes played.
+  RTTTL_TRACE_STOP,           // the melody is stopped. The value is the index of the next note.
+  RTTTL_TRACE_PAUSE,          // the melody is paused. The value is the index of the next note.
+  RTTTL_TRACE_RESUME,         // the melody is resumed. The value is the index of the next note.
+};
+
+static constexpr uint16_t RTTTL_LOOP_FOREVER = 0xFFFF;  // repeat count of a loop that never ends. See nonblocking::setLoop().
+static constexpr uint16_t RTTTL_LOOP_END = 0xFFFF;      // end note of a loop that ends with the melody. See nonblocking::setLoop().
+static constexpr unsigned long RTTTL_NO_EVENT = (unsigned long)-1; // time until the next event of a melody that is done or paused. See nonblocking::millisUntilNextEvent().
+static constexpr uint16_t RTTTL_UNBOUNDED_LENGTH = 0xFFFF; // maximum length of a text melody that is only bounded by its '\0' character. See nonblocking::begin().
+
+struct rtttl_stream_t;
+
+#ifdef ANY_RTTTL_TELEMETRY
+/****************************************************************************
+ * Description:
+ *   Defines the playback statistics of a context.
+ *   Only available when ANY_RTTTL_TELEMETRY is defined. See the telemetry namespace.
+ ****************************************************************************/
+typedef struct rtttl_telemetry_t {
+  uint16_t notesPlayed;         // number of notes played.
+  unsigned long maxLateness;    // maximum delay between the scheduled start of a note and the call to play() that started it.
+  unsigned long totalLateness;  // sum of the delays of all notes but the first one.
+  unsigned long maxPollGap;     // maximum time between two calls to play().
+  unsigned long lastPoll;       // time of the last call to play().
+  bool polled;                  // true when lastPoll is valid.
+  uint16_t notesParsed;         // number of notes parsed or decoded by play().
+  unsigned long maxParseUs;     // maximum time spent parsing a note, in microseconds.
+  unsigned long totalParseUs;   // sum of the time spent parsing notes, in microseconds.
+} rtttl_telemetry_t;
+#endif // ANY_RTTTL_TELEMETRY
+
 typedef struct rtttl_context_t {
   byte pin;                   // the pin assigned to this context.
+  byte format;                // format of the melody. See rtttl_format_t.
   const char * buffer;        // address of the melody. Can be from RAM or PROGMEM address space.
   const char * next;          // address of the next byte to process within buffer.
+  uint16_t maxLength;         // maximum number of bytes read from buffer. The parser stops at the first '\0' or after maxLength bytes, unless maxLength is RTTTL_UNBOUNDED_LENGTH.
   GetCharFuncPtr getCharPtr;  // a custom function to get the first byte from `next` buffer.
   byte melodyDefaultDur;      // default duration of notes in the melody. Use this value for notes that do not specify a duration.
   byte melodyDefaultOct;      // default  octave  of notes in the melody. Use this value for notes that do not specify an octave.
@@ -47,6 +135,26 @@ typedef struct rtttl_context_t {
   unsigned long nextNoteMs;   // timestamp in milliseconds of end of note (start of next).
   bool playing;
   byte noteOffset;
+  const rtttl_note_event_t * events; // address of a precompiled melody. Used with RTTTL_FORMAT_EVENTS.
+  uint16_t notesCount;        // number of notes of a precompiled or binary melody.
+  uint16_t noteIndex;         // index of the next note to play.
+  byte noteDivisor;           // duration of the current note (4 for a quarter note). 0 if unknown.
+  byte noteDots;              // number of dots of the current note.
+  bool hasDeadline;           // true when nextNoteUs is the end of the previous note. Used with RTTTL_TIMING_MICROS.
+  unsigned long nextNoteUs;   // timestamp in microseconds of end of note (start of next). Used with RTTTL_TIMING_MICROS.
+  uint16_t tempoRemainder;    // fraction of microsecond carried to the next note, in 1/bpm microseconds. Used with RTTTL_TIMING_MICROS.
+  bool paused;                // true when the melody is paused. See nonblocking::pause().
+  unsigned long remainingTime; // time left of the current note when the melody was paused, in milliseconds or microseconds. See setTimingMode().
+  uint16_t loopStartOffset;   // position of the first note of the loop. Offset in bytes from the start of a text melody or index of the note for other formats.
+  uint16_t loopStartNote;     // index of the first note of the loop.
+  uint16_t loopEndNote;       // index of the note following the last note of the loop. RTTTL_LOOP_END for the end of the melody.
+  uint16_t loopCount;         // number of repeats left. RTTTL_LOOP_FOREVER to repeat forever. See setLoop().
+  rtttl_stream_t * stream;    // the parser of a streamed melody. Used with RTTTL_FORMAT_STREAM.
+  ToneFuncPtr tone;           // the tone() function of the melody. Assigned by begin().
+  NoToneFuncPtr noTone;       // the noTone() function of the melody. Assigned by begin().
+#ifdef ANY_RTTTL_TELEMETRY
+  rtttl_telemetry_t telemetry; // playback statistics. See the telemetry namespace.
+#endif
 } rtttl_context_t;
 
 /****************************************************************************
@@ -69,21 +177,31 @@ void initContext(rtttl_context_t & c);
 
 /****************************************************************************
  * Description:
- *   Defines a function pointer to a tone() function
+ *   Defines a function pointer to a millis() function
  ****************************************************************************/
-typedef void (*ToneFuncPtr)(uint8_t pin, unsigned int frequency, unsigned long duration);
+typedef unsigned long (*MillisFuncPtr)(void);
 
 /****************************************************************************
  * Description:
- *   Defines a function pointer to a noTone() function
+ *   Defines a function pointer to a micros() function
  ****************************************************************************/
-typedef void (*NoToneFuncPtr)(uint8_t pin);
+typedef unsigned long (*MicrosFuncPtr)(void);
 
 /****************************************************************************
  * Description:
- *   Defines a function pointer to a millis() function
+ *   Defines a function pointer to a function that sleeps for the given
+ *   number of milliseconds. See setSleepFunction().
  ****************************************************************************/
-typedef unsigned long (*MillisFuncPtr)(void);
+typedef void (*SleepFuncPtr)(unsigned long iMillis);
+
+/****************************************************************************
+ * Description:
+ *   Defines the clock used for timing notes.
+ ****************************************************************************/
+enum rtttl_timing_t {
+  RTTTL_TIMING_MILLIS = 0,    // notes are timed with millis(). Each note starts when play() is called after the end of the previous note. Default mode.
+  RTTTL_TIMING_MICROS,        // notes are timed with micros(). Each note starts at the exact end of the previous note, without drift.
+};
 
 /****************************************************************************
  * Description:
@@ -109,6 +227,44 @@ void setNoToneFunction(NoToneFuncPtr iFunc);
  ****************************************************************************/
 void setMillisFunction(MillisFuncPtr iFunc);
 
+/****************************************************************************
+ * Description:
+ *   Defines the micros() function used by AnyRtttl.
+ *   Required by the RTTTL_TIMING_MICROS timing mode.
+ * Parameters:
+ *   iFunc: Pointer to a micros() replacement function.
+ ****************************************************************************/
+void setMicrosFunction(MicrosFuncPtr iFunc);
+
+/****************************************************************************
+ * Description:
+ *   Defines the function used by the blocking API to wait between notes.
+ *   Without a sleep function (default), the blocking API calls
+ *   nonblocking::play() and yield() continuously until the melody is done.
+ *   With a sleep function, the blocking API sleeps until the end of each
+ *   note. The function may put the board in a low power mode but the
+ *   millis() or micros() function of AnyRtttl must keep counting.
+ * Parameters:
+ *   iFunc: Pointer to a sleep function. NULL to disable sleeping.
+ ****************************************************************************/
+void setSleepFunction(SleepFuncPtr iFunc);
+
+/****************************************************************************
+ * Description:
+ *   Defines the clock used for timing notes. See rtttl_timing_t.
+ *   With RTTTL_TIMING_MICROS, the length of each note is computed from the
+ *   tempo in microseconds and the fraction of microsecond is carried to the
+ *   next note. Each note is scheduled from the end of the previous note
+ *   instead of the time play() is called. A late call to play() shortens
+ *   the following notes until the melody is back on time.
+ *   Precompiled melodies (see compile()) are timed with millisecond precision.
+ *   The mode must not be changed while a melody is playing.
+ * Parameters:
+ *   iMode: The timing mode. See rtttl_timing_t.
+ ****************************************************************************/
+void setTimingMode(byte iMode);
+byte getTimingMode();
+
 /****************************************************************************
  * Description:
  *   Read the first byte of a buffer stored in RAM.
@@ -125,6 +281,30 @@ char readCharMem(const char * iBuffer);
  ****************************************************************************/
 char readCharPgm(const char * iBuffer);
 
+/****************************************************************************
+ * Description:
+ *   Parse an RTTTL melody into an array of precompiled notes.
+ *   Precompiled notes can be played without parsing the melody again.
+ *   See nonblocking::begin() and blocking::play() overloads which
+ *   accepts an array of rtttl_note_event_t.
+ * Parameters:
+ *   iBuffer:         The string buffer of the RTTTL melody.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte (char) from the given buffer.
+ *   oEvents:         The output array of notes. Can be NULL to only count the notes of the melody.
+ *   iMaxEvents:      The maximum number of notes that can be written to oEvents.
+ * Returns:
+ *   Returns the number of notes written to oEvents.
+ *   If oEvents is NULL, returns the number of notes in the melody.
+ *   Returns 0 if the melody cannot be parsed.
+ ****************************************************************************/
+uint16_t compile(const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, rtttl_note_event_t * oEvents, uint16_t iMaxEvents);
+
+// helper functions
+inline uint16_t compile(const char * iBuffer, rtttl_note_event_t * oEvents, uint16_t iMaxEvents)             { return compile(iBuffer, &anyrtttl::readCharMem, oEvents, iMaxEvents); }
+inline uint16_t compile(const __FlashStringHelper* str, rtttl_note_event_t * oEvents, uint16_t iMaxEvents)   { return compile((const char *)str, &anyrtttl::readCharPgm, oEvents, iMaxEvents); }
+inline uint16_t compileProgMem(const char * iBuffer, rtttl_note_event_t * oEvents, uint16_t iMaxEvents)      { return compile(iBuffer, &anyrtttl::readCharPgm, oEvents, iMaxEvents); }
+inline uint16_t compile_P(const char * iBuffer, rtttl_note_event_t * oEvents, uint16_t iMaxEvents)           { return compile(iBuffer, &anyrtttl::readCharPgm, oEvents, iMaxEvents); }
+
 
 
 /****************************************************************************
@@ -144,6 +324,31 @@ namespace blocking
  ****************************************************************************/
 void play(rtttl_context_t & c, byte iPin, const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr);
 
+/****************************************************************************
+ * Description:
+ *   Plays a precompiled RTTTL melody.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iEvents:         The array of precompiled notes. See anyrtttl::compile().
+ *   iEventsCount:    The number of notes in iEvents.
+ ****************************************************************************/
+void play(rtttl_context_t & c, byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount);
+
+/****************************************************************************
+ * Description:
+ *   Plays a binary RTTTL melody encoded with 10 or 16 bits per note.
+ *   See BinaryRTTTL.md for details.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iBuffer:         The binary RTTTL melody, starting with the control section.
+ *   iSize:           The size of iBuffer in bytes.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the given buffer.
+ ****************************************************************************/
+void playBinary10(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr);
+void playBinary16(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr);
+
 /****************************************************************************
  * Legacy API functions
  ****************************************************************************/
@@ -153,6 +358,11 @@ inline void play(byte iPin, const __FlashStringHelper* str)
 inline void playProgMem(byte iPin, const char * iBuffer)                          { play(anyrtttl::gGlobalContext, iPin, iBuffer, &anyrtttl::readCharPgm); }
 inline void play_P(byte iPin, const char * iBuffer)                               { play(anyrtttl::gGlobalContext, iPin, iBuffer, &anyrtttl::readCharPgm); }
 inline void play_P(byte iPin, const __FlashStringHelper* str)                     { play(anyrtttl::gGlobalContext, iPin, (const char *)str, &anyrtttl::readCharPgm); }
+inline void play(byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount) { play(anyrtttl::gGlobalContext, iPin, iEvents, iEventsCount); }
+inline void playBinary10(byte iPin, const unsigned char * iBuffer, uint16_t iSize)    { playBinary10(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharMem); }
+inline void playBinary16(byte iPin, const unsigned char * iBuffer, uint16_t iSize)    { playBinary16(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharMem); }
+inline void playBinary10_P(byte iPin, const unsigned char * iBuffer, uint16_t iSize)  { playBinary10(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharPgm); }
+inline void playBinary16_P(byte iPin, const unsigned char * iBuffer, uint16_t iSize)  { playBinary16(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharPgm); }
 
 }; //blocking namespace
 
@@ -168,13 +378,85 @@ namespace nonblocking
  * Description:
  *   Setups the AnyRtttl library for non-blocking mode and ready to
  *   decode a new RTTTL song.
+ *   The song ends at its '\0' character, whatever its length.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iBuffer:         The string buffer of the RTTTL song.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte (char) from the given buffer.
+ *   iOutput:         The output of the melody. See rtttl_output_t.
+ *                    NULL for the functions of setToneFunction() and setNoToneFunction().
+ ****************************************************************************/
+void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput = NULL);
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   decode a new RTTTL song of a known maximum length.
+ *   The parser never reads more than iMaxLength bytes from iBuffer, even
+ *   if the song does not end with a '\0' character. Use this function
+ *   for untrusted songs, for example songs received from the network.
+ *   Parsing time is always proportional to the length of the song.
+ *   The maximum length is at most 65534 bytes. RTTTL_UNBOUNDED_LENGTH
+ *   (65535) does not limit the song: it ends at its '\0' character only.
  * Parameters:
  *   c:               An RTTTL context to keep track of the melody's state.
  *   iPin:            The pin which is connected to the piezo buffer.
  *   iBuffer:         The string buffer of the RTTTL song.
+ *   iMaxLength:      The maximum number of bytes read from iBuffer.
+ *                    RTTTL_UNBOUNDED_LENGTH for a song that ends with a '\0' character.
  *   iGetCharFuncPtr: A function pointer to read 1 byte (char) from the given buffer.
+ *   iOutput:         The output of the melody. See rtttl_output_t.
+ *                    NULL for the functions of setToneFunction() and setNoToneFunction().
+ ****************************************************************************/
+void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, uint16_t iMaxLength, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput = NULL);
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   play a precompiled RTTTL song. The song is not parsed again while playing.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iEvents:         The array of precompiled notes. See anyrtttl::compile().
+ *                    The array must remain valid until the song is done playing.
+ *   iEventsCount:    The number of notes in iEvents.
+ *   iOutput:         The output of the melody. See rtttl_output_t.
+ *                    NULL for the functions of setToneFunction() and setNoToneFunction().
  ****************************************************************************/
-void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr);
+void begin(rtttl_context_t & c, byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount, const rtttl_output_t * iOutput = NULL);
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   play a binary RTTTL song encoded with 10 bits per note.
+ *   Notes are decoded directly from the binary format. See BinaryRTTTL.md.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iBuffer:         The binary RTTTL melody, starting with the control section.
+ *   iSize:           The size of iBuffer in bytes.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the given buffer.
+ *   iOutput:         The output of the melody. See rtttl_output_t.
+ *                    NULL for the functions of setToneFunction() and setNoToneFunction().
+ ****************************************************************************/
+void beginBinary10(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput = NULL);
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   play a binary RTTTL song encoded with 16 bits per note.
+ *   Notes are decoded directly from the binary format. See BinaryRTTTL.md.
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iBuffer:         The binary RTTTL melody, starting with the control section.
+ *   iSize:           The size of iBuffer in bytes.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the given buffer.
+ *   iOutput:         The output of the melody. See rtttl_output_t.
+ *                    NULL for the functions of setToneFunction() and setNoToneFunction().
+ ****************************************************************************/
+void beginBinary16(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput = NULL);
 
 /****************************************************************************
  * Description:
@@ -190,11 +472,39 @@ void play(rtttl_context_t & c);
 /****************************************************************************
  * Description:
  *   Stops playing the current song.
+ *   The rest of the melody is not read. Runs in constant time.
  * Parameters:
  *   c:       An RTTTL context to keep track of the melody's state.
  ****************************************************************************/
 void stop(rtttl_context_t & c);
 
+/****************************************************************************
+ * Description:
+ *   Pauses the current song. The current note is silenced and the time
+ *   left of the note is kept until resume() is called.
+ *   A paused song is still playing: isPlaying() returns true and done() returns false.
+ * Parameters:
+ *   c:       An RTTTL context to keep track of the melody's state.
+ ****************************************************************************/
+void pause(rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Resumes a paused song. The rest of the current note is played
+ *   and the next note starts after the time that was left when paused.
+ * Parameters:
+ *   c:       An RTTTL context to keep track of the melody's state.
+ ****************************************************************************/
+void resume(rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Return true when the given RTTTL melody is paused.
+ * Parameters:
+ *   c:       An RTTTL context to keep track of the melody's state.
+ ****************************************************************************/
+bool isPaused(rtttl_context_t & c);
+
 /****************************************************************************
  * Description:
  *   Return true when the library is playing the given RTTTL melody.
@@ -211,12 +521,33 @@ bool isPlaying(rtttl_context_t & c);
  ****************************************************************************/
 bool done(rtttl_context_t & c);
 
+/****************************************************************************
+ * Description:
+ *   Returns the time until play() has something to do for the given
+ *   melody. The application can sleep or delay() for the returned time
+ *   instead of calling play() continuously.
+ *   The time is rounded down with RTTTL_TIMING_MICROS.
+ * Parameters:
+ *   c:       An RTTTL context to keep track of the melody's state.
+ * Returns:
+ *   Returns the number of milliseconds until the end of the current note.
+ *   Returns 0 if play() must be called now.
+ *   Returns RTTTL_NO_EVENT if the melody is done or paused.
+ ****************************************************************************/
+unsigned long millisUntilNextEvent(const rtttl_context_t & c);
+
 // helper functions
-inline void begin(rtttl_context_t & c, byte iPin, const char * iBuffer)             { begin(c, iPin, iBuffer, &anyrtttl::readCharMem); }
-inline void begin(rtttl_context_t & c, byte iPin, const __FlashStringHelper* str)   { begin(c, iPin, (const char *)str, &anyrtttl::readCharPgm); }
-inline void beginProgMem(rtttl_context_t & c, byte iPin, const char * iBuffer)      { begin(c, iPin, iBuffer, &anyrtttl::readCharPgm); }
-inline void begin_P(rtttl_context_t & c, byte iPin, const char * iBuffer)           { begin(c, iPin, iBuffer, &anyrtttl::readCharPgm); }
-inline void begin_P(rtttl_context_t & c, byte iPin, const __FlashStringHelper* str) { begin(c, iPin, (const char *)str, &anyrtttl::readCharPgm); }
+inline void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, const rtttl_output_t * iOutput = NULL)             { begin(c, iPin, iBuffer, &anyrtttl::readCharMem, iOutput); }
+inline void begin(rtttl_context_t & c, byte iPin, const __FlashStringHelper* str, const rtttl_output_t * iOutput = NULL)   { begin(c, iPin, (const char *)str, &anyrtttl::readCharPgm, iOutput); }
+inline void beginProgMem(rtttl_context_t & c, byte iPin, const char * iBuffer, const rtttl_output_t * iOutput = NULL)      { begin(c, iPin, iBuffer, &anyrtttl::readCharPgm, iOutput); }
+inline void begin_P(rtttl_context_t & c, byte iPin, const char * iBuffer, const rtttl_output_t * iOutput = NULL)           { begin(c, iPin, iBuffer, &anyrtttl::readCharPgm, iOutput); }
+inline void begin_P(rtttl_context_t & c, byte iPin, const __FlashStringHelper* str, const rtttl_output_t * iOutput = NULL) { begin(c, iPin, (const char *)str, &anyrtttl::readCharPgm, iOutput); }
+inline void begin(rtttl_context_t & c, byte iPin, const char * iBuffer, uint16_t iMaxLength, const rtttl_output_t * iOutput = NULL)    { begin(c, iPin, iBuffer, iMaxLength, &anyrtttl::readCharMem, iOutput); }
+inline void begin_P(rtttl_context_t & c, byte iPin, const char * iBuffer, uint16_t iMaxLength, const rtttl_output_t * iOutput = NULL)  { begin(c, iPin, iBuffer, iMaxLength, &anyrtttl::readCharPgm, iOutput); }
+inline void beginBinary10(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, const rtttl_output_t * iOutput = NULL)    { beginBinary10(c, iPin, iBuffer, iSize, &anyrtttl::readCharMem, iOutput); }
+inline void beginBinary16(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, const rtttl_output_t * iOutput = NULL)    { beginBinary16(c, iPin, iBuffer, iSize, &anyrtttl::readCharMem, iOutput); }
+inline void beginBinary10_P(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, const rtttl_output_t * iOutput = NULL)  { beginBinary10(c, iPin, iBuffer, iSize, &anyrtttl::readCharPgm, iOutput); }
+inline void beginBinary16_P(rtttl_context_t & c, byte iPin, const unsigned char * iBuffer, uint16_t iSize, const rtttl_output_t * iOutput = NULL)  { beginBinary16(c, iPin, iBuffer, iSize, &anyrtttl::readCharPgm, iOutput); }
 
 /****************************************************************************
  * Legacy API functions
@@ -227,13 +558,33 @@ inline void begin(byte iPin, const __FlashStringHelper* str)
 inline void beginProgMem(byte iPin, const char * iBuffer)                           { begin(anyrtttl::gGlobalContext, iPin, iBuffer, &anyrtttl::readCharPgm); }
 inline void begin_P(byte iPin, const char * iBuffer)                                { begin(anyrtttl::gGlobalContext, iPin, iBuffer, &anyrtttl::readCharPgm); }
 inline void begin_P(byte iPin, const __FlashStringHelper* str)                      { begin(anyrtttl::gGlobalContext, iPin, (const char *)str, &anyrtttl::readCharPgm); }
+inline void begin(byte iPin, const char * iBuffer, uint16_t iMaxLength)             { begin(anyrtttl::gGlobalContext, iPin, iBuffer, iMaxLength, &anyrtttl::readCharMem); }
+inline void begin(byte iPin, const rtttl_note_event_t * iEvents, uint16_t iEventsCount) { begin(anyrtttl::gGlobalContext, iPin, iEvents, iEventsCount); }
+inline void beginBinary10(byte iPin, const unsigned char * iBuffer, uint16_t iSize)     { beginBinary10(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharMem); }
+inline void beginBinary16(byte iPin, const unsigned char * iBuffer, uint16_t iSize)     { beginBinary16(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharMem); }
+inline void beginBinary10_P(byte iPin, const unsigned char * iBuffer, uint16_t iSize)   { beginBinary10(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharPgm); }
+inline void beginBinary16_P(byte iPin, const unsigned char * iBuffer, uint16_t iSize)   { beginBinary16(anyrtttl::gGlobalContext, iPin, iBuffer, iSize, &anyrtttl::readCharPgm); }
 inline void play()                                                                  { play(anyrtttl::gGlobalContext); }
 inline void stop()                                                                  { stop(anyrtttl::gGlobalContext); }
+inline void pause()                                                                 { pause(anyrtttl::gGlobalContext); }
+inline void resume()                                                                { resume(anyrtttl::gGlobalContext); }
+inline bool isPaused()                                                              { return isPaused(anyrtttl::gGlobalContext); }
 inline bool done()                                                                  { return done(anyrtttl::gGlobalContext); }
 inline bool isPlaying()                                                             { return isPlaying(anyrtttl::gGlobalContext); }
+inline unsigned long millisUntilNextEvent()                                         { return millisUntilNextEvent(anyrtttl::gGlobalContext); }
 
 }; //nonblocking namespace
 
 }; //anyrtttl namespace
 
+#include "rtttl_player.h"
+#include "rtttl_scheduler.h"
+#include "rtttl_timer.h"
+#include "rtttl_seek.h"
+#include "rtttl_catalog.h"
+#include "rtttl_stream.h"
+#include "rtttl_wire.h"
+#include "rtttl_telemetry.h"
+#include "rtttl_trace.h"
+
 #endif //ANY_RTTTL_H
@@ -0,0 +1,233 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "binrtttl.h"
+
+namespace anyrtttl
+{
+
+/*********************************************************
+ * Binary RTTTL encoder
+ *********************************************************/
+
+static char readLowerCaseChar(const char * & ioNext, GetCharFuncPtr iGetCharFuncPtr)
+{
+  char c = iGetCharFuncPtr(ioNext);
+  if (c != '\0')
+    ioNext++;
+  if (c >= 'A' && c <= 'Z')
+    c += ('a' - 'A');
+  return c;
+}
+
+static bool isWhiteSpace(char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+static void skipWhiteSpace(const char * & ioNext, GetCharFuncPtr iGetCharFuncPtr)
+{
+  while (isWhiteSpace(iGetCharFuncPtr(ioNext)))
+    ioNext++;
+}
+
+static bool readInteger(const char * & ioNext, GetCharFuncPtr iGetCharFuncPtr, uint16_t & oValue)
+{
+  bool found = false;
+  uint32_t value = 0;
+  while (isdigit(iGetCharFuncPtr(ioNext)))
+  {
+    value = (value * 10) + (iGetCharFuncPtr(ioNext) - '0');
+    if (value > 0xFFFF)
+      value = 0xFFFF; // saturate, the value is invalid anyway
+    ioNext++;
+    found = true;
+  }
+  oValue = (uint16_t)value;
+  return found;
+}
+
+static bool encodeControlSection(const char * & ioNext, GetCharFuncPtr iGetCharFuncPtr, RTTTL_CONTROL_SECTION & oSection)
+{
+  uint16_t duration = RTTTL_DEFAULT_DURATION_VALUE;
+  uint16_t octave = RTTTL_DEFAULT_OCTAVE_VALUE;
+  uint16_t bpm = RTTTL_DEFAULT_BPM_VALUE;
+
+  // skip melody name
+  char c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  while (c != ':')
+  {
+    if (c == '\0')
+      return false; // unexpected end of melody
+    c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  }
+
+  // read until the end of control section.
+  c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  while (c != ':')
+  {
+    uint16_t * value = NULL;
+    switch(c)
+    {
+      case 'd': value = &duration; break;
+      case 'o': value = &octave;   break;
+      case 'b': value = &bpm;      break;
+      case ',': break;
+      case '\0':
+        return false; // unexpected end of control section
+      default:
+        if (!isWhiteSpace(c))
+          return false; // unknown character
+        break;
+    };
+
+    if (value != NULL)
+    {
+      skipWhiteSpace(ioNext, iGetCharFuncPtr);
+      if (readLowerCaseChar(ioNext, iGetCharFuncPtr) != '=')
+        return false;
+      skipWhiteSpace(ioNext, iGetCharFuncPtr);
+      if (!readInteger(ioNext, iGetCharFuncPtr, *value))
+        return false;
+    }
+
+    c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  }
+
+  duration_index_t durationIdx = findDurationIndexFromValue(duration);
+  octave_index_t octaveIdx = findOctaveIndexFromValue((octave_value_t)octave);
+  if (durationIdx == INVALID_DURATION_INDEX || octave > 0xFF || octaveIdx == INVALID_OCTAVE_INDEX)
+    return false;
+  if (bpm == 0 || bpm > 1023)
+    return false; // bpm is stored on 10 bits
+
+  oSection.raw = 0;
+  oSection.durationIdx = durationIdx;
+  oSection.octaveIdx = octaveIdx;
+  oSection.bpm = bpm;
+  return true;
+}
+
+// Returns 1 if a note was encoded, 0 at the end of the melody and -1 on error.
+static int encodeNote(const char * & ioNext, GetCharFuncPtr iGetCharFuncPtr, const RTTTL_CONTROL_SECTION & iSection, RTTTL_NOTE & oNote)
+{
+  skipWhiteSpace(ioNext, iGetCharFuncPtr);
+  if (iGetCharFuncPtr(ioNext) == '\0')
+    return 0; // end of melody
+
+  oNote.raw = 0;
+  oNote.durationIdx = iSection.durationIdx;
+  oNote.octaveIdx = iSection.octaveIdx;
+
+  // get note duration, if available
+  uint16_t duration = 0;
+  if (readInteger(ioNext, iGetCharFuncPtr, duration))
+  {
+    duration_index_t durationIdx = findDurationIndexFromValue(duration);
+    if (durationIdx == INVALID_DURATION_INDEX)
+      return -1;
+    oNote.durationIdx = durationIdx;
+  }
+
+  // Parse note characters 1 by 1, until note separator or end of buffer
+  bool hasNote = false;
+  char c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  while (c != ',' && c != '\0')
+  {
+    if (c == '#')
+    {
+      oNote.pound = true;
+    }
+    else if (c == '.')
+    {
+      oNote.dotted = true;
+    }
+    else if (isdigit(c))
+    {
+      octave_index_t octaveIdx = findOctaveIndexFromValue((octave_value_t)(c - '0'));
+      if (octaveIdx == INVALID_OCTAVE_INDEX)
+        return -1;
+      oNote.octaveIdx = octaveIdx;
+    }
+    else if (isValidNoteValue(c) && !hasNote)
+    {
+      oNote.noteIdx = findNoteIndexFromNoteValue(c);
+      hasNote = true;
+    }
+    else if (!isWhiteSpace(c))
+    {
+      return -1; // unknown character
+    }
+    c = readLowerCaseChar(ioNext, iGetCharFuncPtr);
+  }
+
+  if (!hasNote)
+    return -1;
+  return 1;
+}
+
+static void writeBits(unsigned char * oBuffer, uint32_t iBitOffset, uint16_t iValue, byte iBitCount)
+{
+  // Bits are written from the least significant bit to the most significant bit.
+  for(byte i=0; i<iBitCount; i++)
+  {
+    uint32_t bit = iBitOffset + i;
+    unsigned char & b = oBuffer[bit >> 3];
+    if ((bit & 0x07) == 0)
+      b = 0; // first write to this byte. Padding bits are left cleared.
+    if (iValue & (1U << i))
+      b |= (unsigned char)(1 << (bit & 0x07));
+  }
+}
+
+uint16_t encode(const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, byte iBitsPerNote, unsigned char * oBuffer, uint16_t iMaxSize)
+{
+  if (iBuffer == NULL || iGetCharFuncPtr == NULL)
+    return 0;
+  if (iBitsPerNote != RTTTL_NOTE_SIZE_BITS && iBitsPerNote != 8*sizeof(RTTTL_NOTE))
+    return 0;
+
+  const char * next = iBuffer;
+  RTTTL_CONTROL_SECTION section;
+  if (!encodeControlSection(next, iGetCharFuncPtr, section))
+    return 0;
+
+  uint32_t size = sizeof(RTTTL_CONTROL_SECTION);
+  if (oBuffer != NULL)
+  {
+    if (iMaxSize < size)
+      return 0;
+    writeBits(oBuffer, 0, section.raw, 16);
+  }
+
+  uint32_t bitOffset = 0;
+  RTTTL_NOTE note;
+  int result = encodeNote(next, iGetCharFuncPtr, section, note);
+  while (result > 0)
+  {
+    size = sizeof(RTTTL_CONTROL_SECTION) + (bitOffset + iBitsPerNote + 7) / 8;
+    if (size > 0xFFFF)
+      return 0;
+
+    if (oBuffer != NULL)
+    {
+      if (size > iMaxSize)
+        return 0; // output buffer is full
+      writeBits(oBuffer + sizeof(RTTTL_CONTROL_SECTION), bitOffset, note.raw, iBitsPerNote);
+    }
+
+    bitOffset += iBitsPerNote;
+    result = encodeNote(next, iGetCharFuncPtr, section, note);
+  }
+
+  if (result < 0)
+    return 0;
+  return (uint16_t)size;
+}
+
+}; //anyrtttl namespace
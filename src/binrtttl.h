@@ -10,6 +10,7 @@
 
 #include "Arduino.h"
 #include "rtttl_utils.h"
+#include "anyrtttl.h"
 
 #define RTTTL_SONG_NAME_SIZE 11
 #define RTTTL_NOTE_SIZE_BITS 10
@@ -64,7 +65,7 @@ inline char digitToChar(int d) {
     return '0' + d;
 }
 
-char * itoa(int n, char *buf) {
+inline char * itoa(int n, char *buf) {
     int div = 10000;
     while (div > 1 && n / div == 0)
         div /= 10;
@@ -79,7 +80,7 @@ char * itoa(int n, char *buf) {
     return buf;
 }
 
-void toString(const RTTTL_CONTROL_SECTION & ctrl_section, const RTTTL_NOTE & note, char * buffer) {
+inline void toString(const RTTTL_CONTROL_SECTION & ctrl_section, const RTTTL_NOTE & note, char * buffer) {
   if (note.durationIdx != ctrl_section.durationIdx)
     buffer = itoa(gNoteDurations[note.durationIdx], buffer);
 
@@ -105,7 +106,7 @@ void toString(const RTTTL_CONTROL_SECTION & ctrl_section, const RTTTL_NOTE & not
   buffer[0] = '\0';
 }
 
-void toString(const RTTTL_CONTROL_SECTION & ctrl_section, char * buffer) {
+inline void toString(const RTTTL_CONTROL_SECTION & ctrl_section, char * buffer) {
   // duration
   buffer[0] = 'd';
   buffer[1] = '=';
@@ -139,6 +140,33 @@ void toString(const RTTTL_CONTROL_SECTION & ctrl_section, char * buffer) {
   buffer[0] = '\0';
 }
 
+/****************************************************************************
+ * Description:
+ *   Encodes an RTTTL text melody to the binary RTTTL format.
+ *   See BinaryRTTTL.md for details.
+ *   The output buffer starts with the control section and is followed
+ *   by all notes encoded with iBitsPerNote bits per note.
+ *   Melodies that cannot be represented in the binary format,
+ *   for example a melody with an invalid duration, octave or bpm,
+ *   are rejected.
+ * Parameters:
+ *   iBuffer:         The string buffer of the RTTTL melody.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte (char) from the given buffer.
+ *   iBitsPerNote:    The number of bits per note. Must be 10 or 16.
+ *   oBuffer:         The output buffer. Can be NULL to only compute the required size.
+ *   iMaxSize:        The size of oBuffer in bytes.
+ * Returns:
+ *   Returns the size in bytes of the encoded melody.
+ *   Returns 0 if the melody cannot be encoded or if oBuffer is too small.
+ ****************************************************************************/
+uint16_t encode(const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, byte iBitsPerNote, unsigned char * oBuffer, uint16_t iMaxSize);
+
+// helper functions
+inline uint16_t encode10(const char * iBuffer, unsigned char * oBuffer, uint16_t iMaxSize)    { return encode(iBuffer, &anyrtttl::readCharMem, 10, oBuffer, iMaxSize); }
+inline uint16_t encode16(const char * iBuffer, unsigned char * oBuffer, uint16_t iMaxSize)    { return encode(iBuffer, &anyrtttl::readCharMem, 16, oBuffer, iMaxSize); }
+inline uint16_t encode10_P(const char * iBuffer, unsigned char * oBuffer, uint16_t iMaxSize)  { return encode(iBuffer, &anyrtttl::readCharPgm, 10, oBuffer, iMaxSize); }
+inline uint16_t encode16_P(const char * iBuffer, unsigned char * oBuffer, uint16_t iMaxSize)  { return encode(iBuffer, &anyrtttl::readCharPgm, 16, oBuffer, iMaxSize); }
+
 }; //anyrtttl namespace
 
 #endif //BINRTTTL_H
@@ -47,7 +47,20 @@ namespace esp32
       void toneSetup(uint8_t pin) {
         ledcAttach(pin, 1000, LEDC_RESOLUTION);
       }
-      
+
+      // LEDC functions of the channel pool
+      static void attachCoreChannel(uint8_t pin, uint8_t channel) {
+        ledcAttachChannel(pin, 1000, LEDC_RESOLUTION, channel);
+      }
+
+      static void detachCoreChannel(uint8_t pin) {
+        ledcDetach(pin);
+      }
+
+      static void writeCoreChannelTone(uint8_t pin, uint8_t, unsigned int frq) {
+        ledcWriteTone(pin, frq);
+      }
+
     #elif ESP_ARDUINO_VERSION >= ESP_ARDUINO_VERSION_VAL(2, 0, 0)
       // Code specific to ESP32 core 2.x
       // Core 2.x uses channels instead of pins:
@@ -57,7 +70,7 @@ namespace esp32
       // See official documentation for migrating from core 2.x to 3.x:
       // https://docs.espressif.com/projects/arduino-esp32/en/latest/migration_guides/2.x_to_3.0.html
 
-      #define ESP32_INVALID_CHANNEL 0xFF
+      #define LEDC_RESOLUTION 10
 
       void noTone(uint8_t pin) {
         uint8_t channel = channelMapFunc(pin);
@@ -75,6 +88,20 @@ namespace esp32
         ledcAttachPin(pin, channel); // Attach the pin to the LEDC channel
       }
 
+      // LEDC functions of the channel pool
+      static void attachCoreChannel(uint8_t pin, uint8_t channel) {
+        ledcSetup(channel, 1000, LEDC_RESOLUTION); // Setup the timer of the channel
+        ledcAttachPin(pin, channel);
+      }
+
+      static void detachCoreChannel(uint8_t pin) {
+        ledcDetachPin(pin);
+      }
+
+      static void writeCoreChannelTone(uint8_t, uint8_t channel, unsigned int frq) {
+        ledcWriteTone(channel, frq);
+      }
+
     #else
       #error ESP32 arduino version unsupported
     #endif
@@ -85,3 +112,145 @@ namespace esp32
 
 }; //esp32 namespace
 #endif // ESP32
+
+namespace esp32
+{
+  // Functions used by the channel pool to drive the LEDC peripheral.
+  // See function setLedcFunctions() to change the default functions.
+#ifdef ESP32
+  LedcAttachFuncPtr ledcAttachFunc = &attachCoreChannel;
+  LedcDetachFuncPtr ledcDetachFunc = &detachCoreChannel;
+  LedcWriteToneFuncPtr ledcWriteToneFunc = &writeCoreChannelTone;
+#else
+  LedcAttachFuncPtr ledcAttachFunc = NULL;
+  LedcDetachFuncPtr ledcDetachFunc = NULL;
+  LedcWriteToneFuncPtr ledcWriteToneFunc = NULL;
+#endif
+
+  // Two consecutive LEDC channels share the same timer.
+  // The pool only uses every other channel to give each pin its own timer.
+  #define ESP32_POOL_CHANNEL_STEP 2
+
+  struct pool_slot_t {
+    bool attached;      // true when a pin is attached to the channel.
+    uint8_t pin;        // the pin attached to the channel.
+    unsigned int frq;   // the frequency of the last tone written to the channel. 0 when silent.
+  };
+
+  static pool_slot_t gPoolSlots[ANY_RTTTL_ESP32_TONE_CHANNELS];
+
+  static inline bool isLedcAssigned() {
+    return (ledcAttachFunc != NULL && ledcDetachFunc != NULL && ledcWriteToneFunc != NULL);
+  }
+
+  static inline uint8_t getSlotChannel(uint8_t slot) {
+    return slot * ESP32_POOL_CHANNEL_STEP;
+  }
+
+  // Returns the slot of the given pin or ANY_RTTTL_ESP32_TONE_CHANNELS if the pin has no channel.
+  static uint8_t findSlot(uint8_t pin) {
+    for(uint8_t i=0; i<ANY_RTTTL_ESP32_TONE_CHANNELS; i++) {
+      if (gPoolSlots[i].attached && gPoolSlots[i].pin == pin)
+        return i;
+    }
+    return ANY_RTTTL_ESP32_TONE_CHANNELS;
+  }
+
+  // Attaches the given pin to a free channel or to the channel of a silent pin.
+  // Returns ANY_RTTTL_ESP32_TONE_CHANNELS if all channels are playing.
+  static uint8_t allocateSlot(uint8_t pin) {
+    uint8_t slot = ANY_RTTTL_ESP32_TONE_CHANNELS;
+    for(uint8_t i=0; i<ANY_RTTTL_ESP32_TONE_CHANNELS; i++) {
+      if (!gPoolSlots[i].attached) {
+        slot = i;
+        break;
+      }
+      if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS && gPoolSlots[i].frq == 0)
+        slot = i; // first silent pin. Used if there is no free channel.
+    }
+    if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS)
+      return slot;
+
+    pool_slot_t & s = gPoolSlots[slot];
+    if (s.attached)
+      ledcDetachFunc(s.pin);
+    ledcAttachFunc(pin, getSlotChannel(slot));
+    s.attached = true;
+    s.pin = pin;
+    s.frq = 0;
+    return slot;
+  }
+
+  static void writeSlotTone(uint8_t slot, unsigned int frq) {
+    pool_slot_t & s = gPoolSlots[slot];
+    if (s.frq == frq)
+      return; // skip redundant writes
+    ledcWriteToneFunc(s.pin, getSlotChannel(slot), frq);
+    s.frq = frq;
+  }
+
+  static void releaseSlot(uint8_t slot) {
+    if (isLedcAssigned()) {
+      writeSlotTone(slot, 0);
+      ledcDetachFunc(gPoolSlots[slot].pin);
+    }
+    gPoolSlots[slot].attached = false;
+    gPoolSlots[slot].frq = 0;
+  }
+
+  void setLedcFunctions(LedcAttachFuncPtr iAttachFunc, LedcDetachFuncPtr iDetachFunc, LedcWriteToneFuncPtr iWriteToneFunc)
+  {
+    releaseAllChannels();
+    ledcAttachFunc = iAttachFunc;
+    ledcDetachFunc = iDetachFunc;
+    ledcWriteToneFunc = iWriteToneFunc;
+  }
+
+  void poolTone(uint8_t pin, unsigned int frq, unsigned long) {
+    // don't care about the given duration
+    if (!isLedcAssigned())
+      return;
+
+    uint8_t slot = findSlot(pin);
+    if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS) {
+      if (frq == 0)
+        return; // already silent
+      slot = allocateSlot(pin);
+      if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS)
+        return; // all channels are playing
+    }
+    writeSlotTone(slot, frq);
+  }
+
+  void poolNoTone(uint8_t pin) {
+    if (!isLedcAssigned())
+      return;
+
+    uint8_t slot = findSlot(pin);
+    if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS)
+      return;
+    writeSlotTone(slot, 0); // the channel of a silent pin can be assigned to another pin
+  }
+
+  void releaseChannel(uint8_t pin) {
+    uint8_t slot = findSlot(pin);
+    if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS)
+      return;
+    releaseSlot(slot);
+  }
+
+  void releaseAllChannels() {
+    for(uint8_t i=0; i<ANY_RTTTL_ESP32_TONE_CHANNELS; i++) {
+      if (gPoolSlots[i].attached)
+        releaseSlot(i);
+    }
+  }
+
+  uint8_t getPoolChannel(uint8_t pin) {
+    uint8_t slot = findSlot(pin);
+    if (slot == ANY_RTTTL_ESP32_TONE_CHANNELS)
+      return ESP32_INVALID_CHANNEL;
+    return getSlotChannel(slot);
+  }
+
+}; //esp32 namespace
@@ -73,4 +73,99 @@ void toneSetup(uint8_t pin);
 
 #endif // ESP32
 
+/****************************************************************************
+ * Channel pool
+ *
+ * The pool gives each pin its own LEDC channel and timer the first time a
+ * tone is played on the pin. No channel map function and no toneSetup()
+ * call are required. The pool works with ESP32 core version 2.x and 3.x.
+ *
+ * The channel of a silent pin is released to the pool: it is assigned to
+ * another pin when all channels are in use. Until then, the pin keeps its
+ * channel and playing a new tone does not attach the pin again.
+ * Stopping a melody does not detach its pin either: channels are released
+ * lazily. Call releaseChannel() to detach a pin immediately.
+ *
+ * The pool calls the LEDC functions of the ESP32 core through function
+ * pointers. On other platforms, the LEDC functions must be assigned with
+ * setLedcFunctions(). This allows testing the pool with mock functions.
+ ****************************************************************************/
+#ifndef ANY_RTTTL_ESP32_TONE_CHANNELS
+#define ANY_RTTTL_ESP32_TONE_CHANNELS 4 // number of pins that can play a tone at the same time. Each pin uses its own LEDC timer.
+#endif
+
+#define ESP32_INVALID_CHANNEL 0xFF
+
+namespace esp32
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines a function that attaches a pin to an LEDC channel.
+ ****************************************************************************/
+typedef void (*LedcAttachFuncPtr)(uint8_t pin, uint8_t channel);
+
+/****************************************************************************
+ * Description:
+ *   Defines a function that detaches a pin from its LEDC channel.
+ ****************************************************************************/
+typedef void (*LedcDetachFuncPtr)(uint8_t pin);
+
+/****************************************************************************
+ * Description:
+ *   Defines a function that outputs a tone on the LEDC channel of a pin.
+ *   A frequency of 0 silences the pin.
+ ****************************************************************************/
+typedef void (*LedcWriteToneFuncPtr)(uint8_t pin, uint8_t channel, unsigned int frq);
+
+/****************************************************************************
+ * Description:
+ *   Defines the LEDC functions used by the channel pool.
+ *   On ESP32, the functions of the ESP32 core are used by default.
+ *   All channels of the pool are released first.
+ * Parameters:
+ *   iAttachFunc:    A function that attaches a pin to a channel.
+ *   iDetachFunc:    A function that detaches a pin from its channel.
+ *   iWriteToneFunc: A function that outputs a tone on a channel.
+ ****************************************************************************/
+void setLedcFunctions(LedcAttachFuncPtr iAttachFunc, LedcDetachFuncPtr iDetachFunc, LedcWriteToneFuncPtr iWriteToneFunc);
+
+/****************************************************************************
+ * Description:
+ *   Function poolTone() outputs a tone on the given pin with a channel of
+ *   the pool. The first tone of a pin allocates a free channel.
+ *   The tone is ignored if all channels are playing.
+ *   The channel is only written if the frequency has changed.
+ *   The duration argument is ignored. Compatible with setToneFunction().
+ ****************************************************************************/
+void poolTone(uint8_t pin, unsigned int frq, unsigned long duration);
+
+/****************************************************************************
+ * Description:
+ *   Function poolNoTone() silences the given pin and releases its channel
+ *   to the pool. Compatible with setNoToneFunction().
+ ****************************************************************************/
+void poolNoTone(uint8_t pin);
+
+/****************************************************************************
+ * Description:
+ *   Silences the given pin and detaches it from its channel.
+ ****************************************************************************/
+void releaseChannel(uint8_t pin);
+
+/****************************************************************************
+ * Description:
+ *   Silences all pins of the pool and detaches them from their channels.
+ ****************************************************************************/
+void releaseAllChannels();
+
+/****************************************************************************
+ * Description:
+ *   Returns the channel of the pool assigned to the given pin.
+ *   Returns ESP32_INVALID_CHANNEL if the pin has no channel.
+ ****************************************************************************/
+uint8_t getPoolChannel(uint8_t pin);
+
+}; //esp32 namespace
+
 #endif //ANY_RTTTL_H
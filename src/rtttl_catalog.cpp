@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_catalog.h"
+
+namespace anyrtttl
+{
+
+namespace catalog
+{
+
+static const char CATALOG_MAGIC[] = { 'R', 'T', 'C', '1' };
+
+// Offsets of the fields of an entry
+static const byte ENTRY_HASH_OFFSET   = 0;
+static const byte ENTRY_OFFSET_OFFSET = 4;
+static const byte ENTRY_SIZE_OFFSET   = 8;
+static const byte ENTRY_FORMAT_OFFSET = 10;
+
+static uint16_t readUInt16(const unsigned char * iBuffer, GetCharFuncPtr iGetCharFuncPtr)
+{
+  const char * p = (const char *)iBuffer;
+  return (uint16_t)((byte)iGetCharFuncPtr(p) | ((uint16_t)(byte)iGetCharFuncPtr(p+1) << 8));
+}
+
+static uint32_t readUInt32(const unsigned char * iBuffer, GetCharFuncPtr iGetCharFuncPtr)
+{
+  return (uint32_t)readUInt16(iBuffer, iGetCharFuncPtr) | ((uint32_t)readUInt16(iBuffer+2, iGetCharFuncPtr) << 16);
+}
+
+static const unsigned char * getEntry(const unsigned char * iCatalog, uint16_t iId)
+{
+  return iCatalog + CATALOG_HEADER_SIZE + (uint32_t)iId * CATALOG_ENTRY_SIZE;
+}
+
+static void readMelody(const unsigned char * iCatalog, uint16_t iId, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr)
+{
+  const unsigned char * entry = getEntry(iCatalog, iId);
+  oMelody.buffer = iCatalog + readUInt32(entry + ENTRY_OFFSET_OFFSET, iGetCharFuncPtr);
+  oMelody.size = readUInt16(entry + ENTRY_SIZE_OFFSET, iGetCharFuncPtr);
+  oMelody.format = (byte)iGetCharFuncPtr((const char *)entry + ENTRY_FORMAT_OFFSET);
+}
+
+uint16_t getCount(const unsigned char * iCatalog, GetCharFuncPtr iGetCharFuncPtr)
+{
+  if (iCatalog == NULL)
+    return 0;
+
+  for(byte i=0; i<sizeof(CATALOG_MAGIC); i++)
+  {
+    if (iGetCharFuncPtr((const char *)iCatalog + i) != CATALOG_MAGIC[i])
+      return 0; // not a catalog
+  }
+
+  return readUInt16(iCatalog + sizeof(CATALOG_MAGIC), iGetCharFuncPtr);
+}
+
+bool getById(const unsigned char * iCatalog, uint16_t iId, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr)
+{
+  if (iId >= getCount(iCatalog, iGetCharFuncPtr))
+    return false;
+
+  readMelody(iCatalog, iId, oMelody, iGetCharFuncPtr);
+  return true;
+}
+
+bool findByHash(const unsigned char * iCatalog, uint32_t iHash, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr)
+{
+  // binary search in the sorted entries
+  uint16_t first = 0;
+  uint16_t last = getCount(iCatalog, iGetCharFuncPtr);
+  while (first < last)
+  {
+    uint16_t middle = first + (last - first) / 2;
+    uint32_t hash = readUInt32(getEntry(iCatalog, middle) + ENTRY_HASH_OFFSET, iGetCharFuncPtr);
+    if (hash == iHash)
+    {
+      readMelody(iCatalog, middle, oMelody, iGetCharFuncPtr);
+      return true;
+    }
+    if (hash < iHash)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return false;
+}
+
+void begin(rtttl_context_t & c, byte iPin, const rtttl_catalog_melody_t & iMelody, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput)
+{
+  switch(iMelody.format)
+  {
+    case RTTTL_FORMAT_BINARY10:
+      nonblocking::beginBinary10(c, iPin, iMelody.buffer, iMelody.size, iGetCharFuncPtr, iOutput);
+      break;
+    case RTTTL_FORMAT_BINARY16:
+      nonblocking::beginBinary16(c, iPin, iMelody.buffer, iMelody.size, iGetCharFuncPtr, iOutput);
+      break;
+    default:
+      nonblocking::begin(c, iPin, (const char *)iMelody.buffer, iMelody.size, iGetCharFuncPtr, iOutput);
+      break;
+  };
+}
+
+}; //catalog namespace
+
+}; //anyrtttl namespace
@@ -0,0 +1,131 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_CATALOG_H
+#define RTTTL_CATALOG_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines a melody found in a catalog.
+ ****************************************************************************/
+typedef struct rtttl_catalog_melody_t {
+  const unsigned char * buffer; // address of the melody. In the same address space as the catalog.
+  uint16_t size;                // size of the melody in bytes. Text melodies include the terminating '\0'.
+  byte format;                  // format of the melody. See rtttl_format_t.
+} rtttl_catalog_melody_t;
+
+/****************************************************************************
+ * Catalog API
+ *
+ * A catalog stores many melodies in a single blob, usually in PROGMEM.
+ * Melodies are found by id or by name with a binary search in the blob.
+ * The names of the melodies are not stored, only their hash.
+ * Use the anyrtttl_catalog tool to generate a catalog.
+ *
+ * Format of a catalog. All values are little endian:
+ *   header:  4 bytes  magic "RTC1"
+ *            2 bytes  number of melodies
+ *            2 bytes  reserved
+ *   entries: 12 bytes per melody, sorted by hash. The id of a melody is its index.
+ *            4 bytes  hash of the melody name. See getNameHash().
+ *            4 bytes  offset of the melody from the start of the catalog.
+ *            2 bytes  size of the melody in bytes.
+ *            1 byte   format of the melody. See rtttl_format_t.
+ *            1 byte   reserved
+ *   melodies
+ ****************************************************************************/
+namespace catalog
+{
+
+static constexpr uint16_t CATALOG_HEADER_SIZE = 8;
+static constexpr uint16_t CATALOG_ENTRY_SIZE = 12;
+
+/****************************************************************************
+ * Description:
+ *   Returns the 32 bits FNV-1a hash of the name of a melody.
+ *   Can be computed at compile time.
+ * Parameters:
+ *   iName: The name of the melody.
+ ****************************************************************************/
+constexpr uint32_t getNameHash(const char * iName, uint32_t iHash = 2166136261UL)
+{
+  return (*iName == '\0' ? iHash : getNameHash(iName + 1, (uint32_t)((iHash ^ (uint8_t)*iName) * 16777619UL)));
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of melodies in a catalog.
+ *   Returns 0 if the buffer is not a catalog.
+ * Parameters:
+ *   iCatalog:        The catalog.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the catalog.
+ ****************************************************************************/
+uint16_t getCount(const unsigned char * iCatalog, GetCharFuncPtr iGetCharFuncPtr);
+
+/****************************************************************************
+ * Description:
+ *   Gets the melody with the given id.
+ * Parameters:
+ *   iCatalog:        The catalog.
+ *   iId:             The id of the melody.
+ *   oMelody:         The melody found in the catalog.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the catalog.
+ * Returns:
+ *   Returns true if the melody is found and false otherwise.
+ ****************************************************************************/
+bool getById(const unsigned char * iCatalog, uint16_t iId, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr);
+
+/****************************************************************************
+ * Description:
+ *   Finds the melody with the given name hash with a binary search.
+ * Parameters:
+ *   iCatalog:        The catalog.
+ *   iHash:           The hash of the name of the melody. See getNameHash().
+ *   oMelody:         The melody found in the catalog.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the catalog.
+ * Returns:
+ *   Returns true if the melody is found and false otherwise.
+ ****************************************************************************/
+bool findByHash(const unsigned char * iCatalog, uint32_t iHash, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr);
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   play a melody of a catalog. See nonblocking::begin().
+ * Parameters:
+ *   c:               An RTTTL context to keep track of the melody's state.
+ *   iPin:            The pin which is connected to the piezo buffer.
+ *   iMelody:         A melody found in a catalog.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the catalog.
+ *   iOutput:         The output of the melody. NULL for the global functions.
+ ****************************************************************************/
+void begin(rtttl_context_t & c, byte iPin, const rtttl_catalog_melody_t & iMelody, GetCharFuncPtr iGetCharFuncPtr, const rtttl_output_t * iOutput = NULL);
+
+// helper functions
+inline bool findByName(const unsigned char * iCatalog, const char * iName, rtttl_catalog_melody_t & oMelody, GetCharFuncPtr iGetCharFuncPtr) { return findByHash(iCatalog, getNameHash(iName), oMelody, iGetCharFuncPtr); }
+inline uint16_t getCount(const unsigned char * iCatalog)                                                    { return getCount(iCatalog, &anyrtttl::readCharMem); }
+inline uint16_t getCount_P(const unsigned char * iCatalog)                                                  { return getCount(iCatalog, &anyrtttl::readCharPgm); }
+inline bool getById(const unsigned char * iCatalog, uint16_t iId, rtttl_catalog_melody_t & oMelody)         { return getById(iCatalog, iId, oMelody, &anyrtttl::readCharMem); }
+inline bool getById_P(const unsigned char * iCatalog, uint16_t iId, rtttl_catalog_melody_t & oMelody)       { return getById(iCatalog, iId, oMelody, &anyrtttl::readCharPgm); }
+inline bool findByHash(const unsigned char * iCatalog, uint32_t iHash, rtttl_catalog_melody_t & oMelody)    { return findByHash(iCatalog, iHash, oMelody, &anyrtttl::readCharMem); }
+inline bool findByHash_P(const unsigned char * iCatalog, uint32_t iHash, rtttl_catalog_melody_t & oMelody)  { return findByHash(iCatalog, iHash, oMelody, &anyrtttl::readCharPgm); }
+inline bool findByName(const unsigned char * iCatalog, const char * iName, rtttl_catalog_melody_t & oMelody)    { return findByHash(iCatalog, getNameHash(iName), oMelody, &anyrtttl::readCharMem); }
+inline bool findByName_P(const unsigned char * iCatalog, const char * iName, rtttl_catalog_melody_t & oMelody)  { return findByHash(iCatalog, getNameHash(iName), oMelody, &anyrtttl::readCharPgm); }
+inline void begin(rtttl_context_t & c, byte iPin, const rtttl_catalog_melody_t & iMelody, const rtttl_output_t * iOutput = NULL)    { begin(c, iPin, iMelody, &anyrtttl::readCharMem, iOutput); }
+inline void begin_P(rtttl_context_t & c, byte iPin, const rtttl_catalog_melody_t & iMelody, const rtttl_output_t * iOutput = NULL)  { begin(c, iPin, iMelody, &anyrtttl::readCharPgm, iOutput); }
+
+}; //catalog namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_CATALOG_H
@@ -0,0 +1,284 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_MELODY_H
+#define RTTTL_MELODY_H
+
+#include "Arduino.h"
+#include "binrtttl.h"
+
+/****************************************************************************
+ * Description:
+ *   Compiles an RTTTL string literal into a 16 bits per note binary melody
+ *   at compile time. The result must be assigned to a constexpr variable.
+ *   A malformed melody fails the build.
+ *   The melody is scanned by halves: the constexpr recursion depth grows with
+ *   the logarithm of the number of notes. The melody is at most 65534
+ *   characters long and has at most 32766 notes.
+ * Example:
+ *   constexpr auto song = ANY_RTTTL_MELODY("tetris:d=4,o=5,b=160:e6,8b,8c6");
+ *   anyrtttl::blocking::playBinary16(BUZZER_PIN, song.data, song.size());
+ ****************************************************************************/
+#define ANY_RTTTL_MELODY(str) anyrtttl::make_melody<anyrtttl::detail::countMelodyNotes(str)>(str)
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Description:
+ *   A melody encoded with 16 bits per note, computed at compile time.
+ *   The `data` member uses the same layout as anyrtttl::encode16() and can be
+ *   played with blocking::playBinary16() or nonblocking::beginBinary16().
+ *   Use the `_P` variants if the melody is declared with PROGMEM.
+ ****************************************************************************/
+template<uint16_t N>
+struct rtttl_melody_t
+{
+  unsigned char data[sizeof(RTTTL_CONTROL_SECTION) + N*sizeof(RTTTL_NOTE)];
+
+  constexpr uint16_t size() const   { return sizeof(data); }  // size of the melody in bytes.
+  constexpr uint16_t count() const  { return N; }             // number of notes of the melody.
+};
+
+namespace detail
+{
+
+// Not constexpr on purpose. Calling this function while compiling a melody
+// at compile time is not a constant expression and fails the build.
+inline int malformedRtttlMelody(const char * /*iReason*/) { return 0; }
+
+// Sequence of indices for expanding the bytes of a melody (C++11 compatible)
+template<uint16_t... I> struct index_sequence { typedef index_sequence type; };
+
+template<class S1, class S2> struct concat_index_sequence;
+template<uint16_t... I1, uint16_t... I2>
+struct concat_index_sequence<index_sequence<I1...>, index_sequence<I2...> > : index_sequence<I1..., (uint16_t)(sizeof...(I1) + I2)...> {};
+
+template<uint16_t N>
+struct make_index_sequence : concat_index_sequence<typename make_index_sequence<N/2>::type, typename make_index_sequence<N - N/2>::type> {};
+template<> struct make_index_sequence<0> : index_sequence<> {};
+template<> struct make_index_sequence<1> : index_sequence<0> {};
+
+// Character helpers
+constexpr bool isMelodyDigit(char c)  { return (c >= '0' && c <= '9'); }
+constexpr bool isMelodySpace(char c)  { return (c == ' ' || c == '\t' || c == '\r' || c == '\n'); }
+constexpr char toMelodyLower(char c)  { return (c >= 'A' && c <= 'Z' ? (char)(c + ('a' - 'A')) : c); }
+
+constexpr uint16_t skipMelodySpaces(const char * s, uint16_t p) {
+  return isMelodySpace(s[p]) ? skipMelodySpaces(s, p+1) : p;
+}
+constexpr uint16_t skipMelodyDigits(const char * s, uint16_t p) {
+  return isMelodyDigit(s[p]) ? skipMelodyDigits(s, p+1) : p;
+}
+constexpr uint16_t readMelodyInteger(const char * s, uint16_t p, uint32_t value) {
+  return isMelodyDigit(s[p]) ? readMelodyInteger(s, p+1, (value*10 + (s[p]-'0') > 0xFFFF ? 0xFFFF : value*10 + (s[p]-'0'))) : (uint16_t)value;
+}
+// Range scans. A range [p, q) of the melody is split in halves so that the
+// recursion depth is logarithmic in the length of the range.
+static constexpr uint16_t MELODY_NOT_FOUND = 0xFFFF;
+
+constexpr uint16_t findMelodyCharIn(const char * s, uint16_t p, uint16_t q, char c);
+constexpr uint16_t findMelodyCharSplit(uint16_t left, const char * s, uint16_t m, uint16_t q, char c) {
+  return left != MELODY_NOT_FOUND ? left : findMelodyCharIn(s, m, q, c);
+}
+constexpr uint16_t findMelodyCharIn(const char * s, uint16_t p, uint16_t q, char c) {
+  return q <= p ? MELODY_NOT_FOUND :
+         q - p == 1 ? (s[p] == c ? p : MELODY_NOT_FOUND) :
+         findMelodyCharSplit(findMelodyCharIn(s, p, p + (q-p)/2, c), s, p + (q-p)/2, q, c);
+}
+constexpr uint16_t checkMelodyChar(uint16_t p) {
+  return p == MELODY_NOT_FOUND ? (uint16_t)malformedRtttlMelody("missing ':' separator") : p;
+}
+constexpr uint16_t findMelodyChar(const char * s, uint16_t p, uint16_t q, char c) {
+  return checkMelodyChar(findMelodyCharIn(s, p, q, c));
+}
+constexpr uint16_t countMelodyChar(const char * s, uint16_t p, uint16_t q, char c) {
+  return q <= p ? 0 :
+         q - p == 1 ? (s[p] == c ? 1 : 0) :
+         countMelodyChar(s, p, p + (q-p)/2, c) + countMelodyChar(s, p + (q-p)/2, q, c);
+}
+constexpr bool isMelodyBlank(const char * s, uint16_t p, uint16_t q) {
+  return q <= p ? true :
+         q - p == 1 ? isMelodySpace(s[p]) :
+         isMelodyBlank(s, p, p + (q-p)/2) && isMelodyBlank(s, p + (q-p)/2, q);
+}
+
+// Returns the position of the character c of the given index (0 based) within [p, q).
+constexpr uint16_t findMelodyNthChar(const char * s, uint16_t p, uint16_t q, char c, uint16_t index);
+constexpr uint16_t findMelodyNthCharSplit(const char * s, uint16_t p, uint16_t m, uint16_t q, char c, uint16_t index, uint16_t leftCount) {
+  return index < leftCount ? findMelodyNthChar(s, p, m, c, index) : findMelodyNthChar(s, m, q, c, index - leftCount);
+}
+constexpr uint16_t findMelodyNthChar(const char * s, uint16_t p, uint16_t q, char c, uint16_t index) {
+  return q - p == 1 ? p : findMelodyNthCharSplit(s, p, p + (q-p)/2, q, c, index, countMelodyChar(s, p, p + (q-p)/2, c));
+}
+
+// Index lookups in the library tables
+constexpr duration_index_t findMelodyDurationIndex(uint16_t value, duration_index_t i) {
+  return i >= gNoteDurationsCount ? (duration_index_t)malformedRtttlMelody("invalid duration") :
+         gNoteDurations[i] == value ? i : findMelodyDurationIndex(value, i+1);
+}
+constexpr octave_index_t findMelodyOctaveIndex(uint16_t value, octave_index_t i) {
+  return i >= gNoteOctavesCount ? (octave_index_t)malformedRtttlMelody("invalid octave") :
+         gNoteOctaves[i] == value ? i : findMelodyOctaveIndex(value, i+1);
+}
+constexpr note_index_t findMelodyNoteIndex(char value, note_index_t i) {
+  return i >= gNoteValuesCount ? (note_index_t)malformedRtttlMelody("invalid note") :
+         gNoteValues[i] == value ? i : findMelodyNoteIndex(value, i+1);
+}
+
+// Control section. The end of the melody is the position of its '\0' character.
+constexpr uint16_t getControlSectionStart(const char * s, uint16_t end) {
+  return findMelodyChar(s, 0, end, ':') + 1;
+}
+constexpr uint16_t getNotesStart(const char * s, uint16_t end) {
+  return findMelodyChar(s, getControlSectionStart(s, end), end, ':') + 1;
+}
+constexpr uint16_t skipControlSeparators(const char * s, uint16_t p) {
+  return (isMelodySpace(s[p]) || s[p] == ',') ? skipControlSeparators(s, p+1) : p;
+}
+constexpr uint16_t skipControlEquals(const char * s, uint16_t p) {
+  return s[p] == '=' ? skipMelodySpaces(s, p+1) : (uint16_t)malformedRtttlMelody("missing '=' in control section");
+}
+constexpr uint16_t readControlInteger(const char * s, uint16_t p) {
+  return isMelodyDigit(s[p]) ? readMelodyInteger(s, p, 0) : (uint16_t)malformedRtttlMelody("missing value in control section");
+}
+constexpr bool isControlKey(char c) {
+  return (c == 'd' || c == 'o' || c == 'b');
+}
+constexpr uint16_t findControlValue(const char * s, uint16_t p, char key, uint16_t def) {
+  return s[p] == ':' ? def :
+         !isControlKey(toMelodyLower(s[p])) ? (uint16_t)malformedRtttlMelody("unknown control section value") :
+         toMelodyLower(s[p]) == key ? readControlInteger(s, skipControlEquals(s, skipMelodySpaces(s, p+1))) :
+         findControlValue(s, skipControlSeparators(s, skipMelodyDigits(s, skipControlEquals(s, skipMelodySpaces(s, p+1)))), key, def);
+}
+constexpr uint16_t getControlValue(const char * s, uint16_t end, char key, uint16_t def) {
+  return findControlValue(s, skipControlSeparators(s, getControlSectionStart(s, end)), key, def);
+}
+constexpr uint16_t checkMelodyBpm(uint16_t bpm) {
+  return (bpm == 0 || bpm > 1023) ? (uint16_t)malformedRtttlMelody("invalid bpm") : bpm;
+}
+constexpr uint16_t getControlSectionRaw(const char * s, uint16_t end) {
+  return (uint16_t)(findMelodyDurationIndex(getControlValue(s, end, 'd', RTTTL_DEFAULT_DURATION_VALUE), 0) |
+                   (findMelodyOctaveIndex(getControlValue(s, end, 'o', RTTTL_DEFAULT_OCTAVE_VALUE), 0) << 3) |
+                   (checkMelodyBpm(getControlValue(s, end, 'b', RTTTL_DEFAULT_BPM_VALUE)) << 5));
+}
+
+// Notes
+static constexpr uint16_t MELODY_NOTE_LETTER_FLAG = 0x8000; // set while parsing when the note letter is found. Not part of the note.
+
+constexpr uint16_t readNoteBody(const char * s, uint16_t p, uint16_t raw) {
+  return (s[p] == ',' || s[p] == '\0') ? ((raw & MELODY_NOTE_LETTER_FLAG) ? (uint16_t)(raw & ~MELODY_NOTE_LETTER_FLAG) : (uint16_t)malformedRtttlMelody("missing note letter")) :
+         s[p] == '#' ? readNoteBody(s, p+1, raw | (1 << 6)) :
+         s[p] == '.' ? readNoteBody(s, p+1, raw | (1 << 7)) :
+         isMelodyDigit(s[p]) ? readNoteBody(s, p+1, (raw & ~(0x03 << 8)) | (findMelodyOctaveIndex(s[p] - '0', 0) << 8)) :
+         isMelodySpace(s[p]) ? readNoteBody(s, p+1, raw) :
+         (raw & MELODY_NOTE_LETTER_FLAG) ? (uint16_t)malformedRtttlMelody("unexpected character in note") :
+         readNoteBody(s, p+1, (raw & ~(0x07 << 3)) | (findMelodyNoteIndex(toMelodyLower(s[p]), 0) << 3) | MELODY_NOTE_LETTER_FLAG);
+}
+constexpr uint16_t readNoteRaw(const char * s, uint16_t p, uint16_t control) {
+  return isMelodyDigit(s[p]) ?
+         readNoteBody(s, skipMelodyDigits(s, p), findMelodyDurationIndex(readMelodyInteger(s, p, 0), 0) | (((control >> 3) & 0x03) << 8)) :
+         readNoteBody(s, p, (control & 0x07) | (((control >> 3) & 0x03) << 8));
+}
+
+// Notes are separated by ',' characters. A blank last note is not counted.
+constexpr uint16_t countMelodyNotesIn(const char * s, uint16_t p, uint16_t q, uint16_t separators) {
+  return separators + (isMelodyBlank(s, separators == 0 ? p : findMelodyNthChar(s, p, q, ',', separators-1) + 1, q) ? 0 : 1);
+}
+constexpr uint16_t countMelodyNotesIn(const char * s, uint16_t p, uint16_t q) {
+  return countMelodyNotesIn(s, p, q, countMelodyChar(s, p, q, ','));
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of notes of an RTTTL melody at compile time.
+ ****************************************************************************/
+template<size_t L>
+constexpr uint16_t countMelodyNotes(const char (&s)[L]) {
+  return ((void)getControlSectionRaw(s, L-1), countMelodyNotesIn(s, getNotesStart(s, L-1), L-1));
+}
+
+// The 16 bits words of the notes of a melody
+template<uint16_t N>
+struct melody_words_t
+{
+  uint16_t words[N > 0 ? N : 1];
+};
+
+template<uint16_t A, uint16_t B, uint16_t... I, uint16_t... J>
+constexpr melody_words_t<A+B> concatMelodyWords(const melody_words_t<A> & a, const melody_words_t<B> & b, index_sequence<I...>, index_sequence<J...>) {
+  return melody_words_t<A+B>{ { a.words[I]..., b.words[J]... } };
+}
+
+// Reads the N notes of the range [p, q) of a melody. The range is split in
+// two halves of notes at the separator in the middle of the range.
+template<uint16_t N>
+struct melody_words_builder
+{
+  static constexpr melody_words_t<N> split(const char * s, uint16_t p, uint16_t m, uint16_t q, uint16_t control) {
+    return concatMelodyWords(melody_words_builder<N/2>::make(s, p, m, control), melody_words_builder<N - N/2>::make(s, m+1, q, control),
+                             typename make_index_sequence<N/2>::type(), typename make_index_sequence<N - N/2>::type());
+  }
+  static constexpr melody_words_t<N> make(const char * s, uint16_t p, uint16_t q, uint16_t control) {
+    return split(s, p, findMelodyNthChar(s, p, q, ',', N/2 - 1), q, control);
+  }
+};
+template<>
+struct melody_words_builder<1>
+{
+  static constexpr melody_words_t<1> make(const char * s, uint16_t p, uint16_t /*q*/, uint16_t control) {
+    return melody_words_t<1>{ { readNoteRaw(s, skipMelodySpaces(s, p), control) } };
+  }
+};
+template<>
+struct melody_words_builder<0>
+{
+  static constexpr melody_words_t<0> make(const char * /*s*/, uint16_t /*p*/, uint16_t /*q*/, uint16_t /*control*/) {
+    return melody_words_t<0>{ { 0 } };
+  }
+};
+
+// Returns the 16 bits word (control section or note) and the byte at the given index of the binary melody
+template<uint16_t N>
+constexpr uint16_t getMelodyWord(uint16_t control, const melody_words_t<N> & notes, uint16_t index) {
+  return index == 0 ? control : notes.words[index-1];
+}
+template<uint16_t N>
+constexpr unsigned char getMelodyByte(uint16_t control, const melody_words_t<N> & notes, uint16_t index) {
+  return (unsigned char)(index % 2 == 0 ? (getMelodyWord(control, notes, index/2) & 0xFF) : (getMelodyWord(control, notes, index/2) >> 8));
+}
+
+template<uint16_t N, uint16_t... I>
+constexpr rtttl_melody_t<N> makeMelodyBytes(uint16_t control, const melody_words_t<N> & notes, index_sequence<I...>) {
+  return rtttl_melody_t<N>{ { getMelodyByte(control, notes, I)... } };
+}
+
+// The control section is computed once and each note is read once.
+template<uint16_t N>
+constexpr rtttl_melody_t<N> makeMelody(const char * s, uint16_t end, uint16_t control) {
+  return (void)(countMelodyNotesIn(s, getNotesStart(s, end), end) == N ? 0 : malformedRtttlMelody("notes count mismatch")),
+         makeMelodyBytes<N>(control, melody_words_builder<N>::make(s, getNotesStart(s, end), end, control), typename make_index_sequence<sizeof(RTTTL_CONTROL_SECTION) + N*sizeof(RTTTL_NOTE)>::type());
+}
+
+}; //detail namespace
+
+/****************************************************************************
+ * Description:
+ *   Compiles an RTTTL melody of N notes into a 16 bits per note binary melody.
+ *   Use the ANY_RTTTL_MELODY() macro to compute N automatically.
+ * Parameters:
+ *   s: The RTTTL melody. Must be a string literal.
+ ****************************************************************************/
+template<uint16_t N, size_t L>
+constexpr rtttl_melody_t<N> make_melody(const char (&s)[L]) {
+  static_assert(L < detail::MELODY_NOT_FOUND, "the melody is longer than 65534 characters");
+  return detail::makeMelody<N>(s, L-1, detail::getControlSectionRaw(s, L-1));
+}
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_MELODY_H
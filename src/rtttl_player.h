@@ -0,0 +1,942 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_PLAYER_H
+#define RTTTL_PLAYER_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Reader policies
+ *
+ * A reader is a type that provides the following member function:
+ *   char read(const char * iBuffer);
+ * which returns the first byte of the given buffer address.
+ * The function can be static. Static readers are inlined by the compiler
+ * in the parser which removes the cost of an indirect call per character.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Description:
+ *   A reader for RTTTL melodies stored in RAM.
+ ****************************************************************************/
+struct ram_reader
+{
+  static inline __attribute__((always_inline)) char read(const char * iBuffer) { return *iBuffer; }
+};
+
+/****************************************************************************
+ * Description:
+ *   A reader for RTTTL melodies stored in PROGMEM.
+ ****************************************************************************/
+struct progmem_reader
+{
+  static inline __attribute__((always_inline)) char read(const char * iBuffer) { return pgm_read_byte_near(iBuffer); }
+};
+
+/****************************************************************************
+ * Description:
+ *   A reader which calls a GetCharFuncPtr function for each byte.
+ *   Used by the rtttl_context_t API for backward compatibility.
+ ****************************************************************************/
+struct function_reader
+{
+  GetCharFuncPtr func;
+  inline __attribute__((always_inline)) char read(const char * iBuffer) { return func(iBuffer); }
+};
+
+/****************************************************************************
+ * Block sources
+ *
+ * A block source is a type that provides the following member function:
+ *   size_t read(const char * iAddress, char * oBlock, size_t iSize);
+ * which copies up to iSize bytes starting at the given address to oBlock
+ * and returns the number of bytes copied. A return value smaller than iSize
+ * is the end of the source. Block sources are used by buffered_reader.
+ ****************************************************************************/
+
+/****************************************************************************
+ * Description:
+ *   A block source for RTTTL melodies stored in PROGMEM.
+ *   Copies a block up to the terminating '\0' of the melody.
+ *   The bytes after the melody are never read.
+ ****************************************************************************/
+struct progmem_source
+{
+  static inline size_t read(const char * iAddress, char * oBlock, size_t iSize)
+  {
+    for(size_t i=0; i<iSize; i++)
+    {
+      oBlock[i] = pgm_read_byte_near(iAddress + i);
+      if (oBlock[i] == '\0')
+        return i+1; // the end of the melody
+    }
+    return iSize;
+  }
+};
+
+/****************************************************************************
+ * Description:
+ *   A block source for RTTTL melodies stored in a file (SD, LittleFS, SPIFFS...).
+ *   T is a file type that provides `bool seek(uint32_t pos)` and
+ *   `read(uint8_t * buf, size_t size)` functions, like SD's File or fs::File.
+ *   Addresses are offsets in the file: begin playing the melody with
+ *   the address (const char *)0 for a melody starting at the first byte.
+ ****************************************************************************/
+template<typename T>
+struct file_source
+{
+  T * file;
+
+  size_t read(const char * iAddress, char * oBlock, size_t iSize)
+  {
+    if (file == NULL || !file->seek((uint32_t)(uintptr_t)iAddress))
+      return 0;
+    int count = (int)file->read((uint8_t *)oBlock, iSize);
+    return (count > 0 ? (size_t)count : 0);
+  }
+};
+
+/****************************************************************************
+ * Description:
+ *   A block source for RTTTL melodies read from an Arduino Stream.
+ *   T is a stream type that provides `int read()` and
+ *   `size_t readBytes(char * buf, size_t size)` functions, like Stream.
+ *   Addresses are offsets from the first byte read from the stream: begin
+ *   playing the melody with the address (const char *)0. A stream cannot
+ *   go back: the melody cannot be seeked or looped. readBytes() waits for
+ *   the stream's timeout. See rtttl_stream_t for melodies received over time.
+ ****************************************************************************/
+template<typename T>
+struct stream_source
+{
+  T * stream;
+  uint32_t position; // offset of the next byte of the stream.
+
+  size_t read(const char * iAddress, char * oBlock, size_t iSize)
+  {
+    uint32_t offset = (uint32_t)(uintptr_t)iAddress;
+    if (stream == NULL || offset < position)
+      return 0;
+
+    // skip the bytes before the block
+    while (position < offset)
+    {
+      if (stream->read() < 0)
+        return 0;
+      position++;
+    }
+
+    size_t count = stream->readBytes(oBlock, iSize);
+    position += count;
+    return count;
+  }
+};
+
+/****************************************************************************
+ * Description:
+ *   A reader which serves the parser from a cached block of BLOCK_SIZE bytes.
+ *   The block is filled with a single call to the Source block source.
+ *   The parser reads each character at least twice (peek and read) which
+ *   only costs a comparison once the block is cached.
+ *   A block starts at the first byte that is not cached and never
+ *   extends past the maximum length of the melody given to begin().
+ *   On AVR, progmem_reader is a single instruction per character. This
+ *   reader mostly helps for sources with a high cost per call: files,
+ *   streams or cores where pgm_read_byte() is not inlined.
+ *   Call invalidate() when the content of the source changes.
+ ****************************************************************************/
+template<typename Source, size_t BLOCK_SIZE = 32>
+struct buffered_reader
+{
+  static_assert(BLOCK_SIZE > 0 && BLOCK_SIZE <= 256, "BLOCK_SIZE must be in range [1, 256]");
+
+  buffered_reader() : source(), blockAddress(0), endAddress(~(uintptr_t)0), blockLength(0), cached(false) {}
+  explicit buffered_reader(const Source & s) : source(s), blockAddress(0), endAddress(~(uintptr_t)0), blockLength(0), cached(false) {}
+
+  inline __attribute__((always_inline)) char read(const char * iBuffer)
+  {
+    uintptr_t offset = (uintptr_t)iBuffer - blockAddress;
+    if (offset < blockLength)
+      return block[offset];
+    return fill(iBuffer);
+  }
+
+  void invalidate()                     { blockLength = 0; cached = false; }
+  void setSource(const Source & s)      { source = s; invalidate(); }
+
+  // Limits the blocks to the given melody. Called by begin().
+  void setLimit(const char * iBuffer, uint16_t iMaxLength)
+  {
+    endAddress = (iMaxLength == RTTTL_UNBOUNDED_LENGTH ? ~(uintptr_t)0 : (uintptr_t)iBuffer + iMaxLength);
+    invalidate();
+  }
+
+  Source source;            // the source of the blocks.
+  uintptr_t blockAddress;   // address of the first byte of block.
+  uintptr_t endAddress;     // address following the last byte of the melody.
+  uint16_t blockLength;     // number of valid bytes in block.
+  char block[BLOCK_SIZE];   // the cached block.
+  bool cached;              // true if block contains the block at blockAddress.
+
+private:
+  char fill(const char * iBuffer)
+  {
+    if (cached && (uintptr_t)iBuffer - blockAddress < BLOCK_SIZE)
+      return '\0'; // the end of the source is in the cached block
+
+    cached = true;
+    blockAddress = (uintptr_t)iBuffer;
+    size_t size = BLOCK_SIZE;
+    if (endAddress - blockAddress < size)
+      size = (size_t)(endAddress - blockAddress);
+    blockLength = (uint16_t)source.read(iBuffer, block, size);
+    if (blockLength > 0)
+      return block[0];
+    return '\0'; // past the end of the source
+  }
+};
+
+namespace detail
+{
+
+// Limits the blocks of a buffered reader to the melody. Other readers only read the requested byte.
+template<typename Reader>
+inline void setReaderLimit(Reader &, const char *, uint16_t) {}
+
+template<typename Source, size_t BLOCK_SIZE>
+inline void setReaderLimit(buffered_reader<Source, BLOCK_SIZE> & r, const char * iBuffer, uint16_t iMaxLength) { r.setLimit(iBuffer, iMaxLength); }
+
+}; //detail namespace
+
+typedef buffered_reader<progmem_source> progmem_buffered_reader; // a reader for RTTTL melodies stored in PROGMEM, read in blocks of 32 bytes.
+
+/****************************************************************************
+ * Parser & player implementation
+ ****************************************************************************/
+
+// Functions assigned with setToneFunction(), setNoToneFunction(), setMillisFunction() and setMicrosFunction().
+extern ToneFuncPtr _tone;
+extern NoToneFuncPtr _noTone;
+extern MillisFuncPtr _millis;
+extern MicrosFuncPtr _micros;
+
+// Timing mode assigned with setTimingMode().
+extern byte gTimingMode;
+
+namespace detail
+{
+
+/****************************************************************************
+ * Description:
+ *   Returns the frequency of a note.
+ * Parameters:
+ *   iScale:      The octave of the note. Must be in range [4, 7].
+ *   iNoteOffset: The offset of the note within the octave. 0 is a pause.
+ ****************************************************************************/
+uint16_t getNoteFrequency(octave_value_t iScale, byte iNoteOffset);
+
+/****************************************************************************
+ * Description:
+ *   Stops the previous note and starts playing a new one.
+ *   Schedule the end of the note in the given context.
+ * Parameters:
+ *   c:           An RTTTL context to keep track of the melody's state.
+ *   iFrequency:  Frequency of the note. Use NOTE_SILENT for a pause.
+ *   iDuration:   Duration of the note in milliseconds.
+ ****************************************************************************/
+void playTone(rtttl_context_t & c, uint16_t iFrequency, duration_value_t iDuration);
+
+/****************************************************************************
+ * Description:
+ *   Decodes the note at c.noteIndex of a binary RTTTL melody
+ *   into the duration, scale and noteOffset of the given context.
+ *   Does not play the note.
+ ****************************************************************************/
+void decodeBinaryNote(rtttl_context_t & c);
+
+#ifdef ANY_RTTTL_TRACE
+/****************************************************************************
+ * Description:
+ *   Adds an event of the given context to the trace buffer. See the trace namespace.
+ *   Use the RTTTL_TRACE() macro which is empty when ANY_RTTTL_TRACE is not defined.
+ ****************************************************************************/
+void trace(const rtttl_context_t & c, byte iEvent, uint16_t iValue);
+
+/****************************************************************************
+ * Description:
+ *   Adds the end of the current note of the given context to the trace buffer.
+ *   Also adds a RTTTL_TRACE_LATE_POLL event if the end of the note is
+ *   reached late. Must be called before the next note is scheduled.
+ ****************************************************************************/
+void traceNoteEnd(const rtttl_context_t & c);
+
+#define RTTTL_TRACE(c, event, value) anyrtttl::detail::trace(c, event, value)
+#define RTTTL_TRACE_NOTE_END(c) anyrtttl::detail::traceNoteEnd(c)
+#else
+#define RTTTL_TRACE(c, event, value)
+#define RTTTL_TRACE_NOTE_END(c)
+#endif // ANY_RTTTL_TRACE
+
+#ifdef ANY_RTTTL_TELEMETRY
+/****************************************************************************
+ * Description:
+ *   Updates the telemetry of the given context. See the telemetry namespace.
+ *   recordPoll() is called by play() when the melody is playing.
+ *   recordNoteStart() is called when a note starts, before the next note is scheduled.
+ *   recordParseTime() is called after a note is parsed, with the value of
+ *   getParseTime() before the note was parsed.
+ ****************************************************************************/
+void recordPoll(rtttl_context_t & c);
+void recordNoteStart(rtttl_context_t & c);
+unsigned long getParseTime();
+void recordParseTime(rtttl_context_t & c, unsigned long iParseStart);
+#endif // ANY_RTTTL_TELEMETRY
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the tone(), noTone() and millis() functions of the
+ *   given context are assigned.
+ ****************************************************************************/
+inline bool isFunctionsAssigned(const rtttl_context_t & c)
+{
+  // Check uninitialized tone(), noTone(), _millis() or _micros() function pointers.
+  if (c.tone == NULL || c.noTone == NULL || _millis == NULL || (gTimingMode == RTTTL_TIMING_MICROS && _micros == NULL)) {
+    #ifdef ANY_RTTTL_DEBUG
+    Serial.println(F( "AnyRtttl initialization incomplete!\n"
+                      "No function defined for tone(), noTone(), _millis() or _micros().\n"
+                      "Use anyrtttl::setToneFunction(), anyrtttl::setNoToneFunction(), anyrtttl::setMillisFunction() or anyrtttl::setMicrosFunction() to assign custom functions."));
+    #endif
+    return false;
+  }
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Initializes a context for a new melody and assigns the tone() and
+ *   noTone() functions of its output. See nonblocking::begin().
+ *   The functions are only checked here: play() uses them without checks.
+ * Parameters:
+ *   c:       The context of the new melody.
+ *   iOutput: The output of the melody. NULL for the global functions.
+ * Returns:
+ *   Returns true if all the functions needed for playing are assigned.
+ ****************************************************************************/
+bool beginContext(rtttl_context_t & c, const rtttl_output_t * iOutput);
+
+/****************************************************************************
+ * Description:
+ *   Returns the current time of the clock of the timing mode.
+ *   See setTimingMode().
+ ****************************************************************************/
+inline unsigned long getTime()
+{
+  return (gTimingMode == RTTTL_TIMING_MICROS ? _micros() : _millis());
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns the time of the end of the current note of the given context
+ *   with the clock of the timing mode.
+ ****************************************************************************/
+inline unsigned long getNextNoteTime(const rtttl_context_t & c)
+{
+  return (gTimingMode == RTTTL_TIMING_MICROS ? c.nextNoteUs : c.nextNoteMs);
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns true if timestamp iTimeA is before timestamp iTimeB.
+ *   Supports the wraparound of millis() and micros().
+ ****************************************************************************/
+inline bool isTimeBefore(unsigned long iTimeA, unsigned long iTimeB)
+{
+  return ((long)(iTimeA - iTimeB) < 0);
+}
+
+/****************************************************************************
+ * Description:
+ *   Moves the given context back to the first note of its loop
+ *   when the end of the loop is reached. See nonblocking::setLoop().
+ *   The control section is not parsed again.
+ * Parameters:
+ *   c:             An RTTTL context to keep track of the melody's state.
+ *   iEndOfMelody:  True if the end of the melody is reached.
+ * Returns:
+ *   Returns true if the context was moved to the start of the loop.
+ ****************************************************************************/
+inline bool loopBack(rtttl_context_t & c, bool iEndOfMelody)
+{
+  if (c.loopCount == 0 || (!iEndOfMelody && c.noteIndex != c.loopEndNote))
+    return false;
+
+  if (c.format == RTTTL_FORMAT_TEXT)
+    c.next = c.buffer + c.loopStartOffset;
+  c.noteIndex = c.loopStartNote;
+  if (c.loopCount != RTTTL_LOOP_FOREVER)
+    c.loopCount--;
+  return true;
+}
+
+inline __attribute__((always_inline)) bool isDigitCharacter(char c) {
+  return (c >= '0' && c <= '9');
+}
+
+inline __attribute__((always_inline)) bool isUpperCaseCharacter(char c) {
+  return (c >= 'A' && c <= 'Z');
+}
+
+// Returns '\0' once maxLength bytes are read. The buffer is never read past maxLength.
+// A melody of RTTTL_UNBOUNDED_LENGTH is only bounded by its '\0' character, whatever its length.
+template<typename Reader>
+inline __attribute__((always_inline)) char peekChar(rtttl_context_t & c, Reader & r)
+{
+  if (c.maxLength != RTTTL_UNBOUNDED_LENGTH && (size_t)(c.next - c.buffer) >= c.maxLength)
+    return '\0';
+  char character = r.read(c.next);
+  return character;
+}
+
+template<typename Reader>
+inline __attribute__((always_inline)) char readChar(rtttl_context_t & c, Reader & r)
+{
+  char character = peekChar(c, r);
+  c.next++;
+  return character;
+}
+
+// Skips the next character, unless it is the end of the melody.
+// The parser never moves past the end of the melody.
+template<typename Reader>
+inline __attribute__((always_inline)) void skipChar(rtttl_context_t & c, Reader & r)
+{
+  if (peekChar(c, r) != '\0')
+    c.next++;
+}
+
+template<typename Reader>
+inline __attribute__((always_inline)) char readLowerCaseChar(rtttl_context_t & c, Reader & r)
+{
+  char character = readChar(c, r);
+
+  // Support uppercase characters in melody
+  if (isUpperCaseCharacter(character)) {
+    character = (character - 'A' + 'a');
+  }
+
+  return character;
+}
+
+template<typename Reader>
+inline __attribute__((always_inline)) void skipCharacters(rtttl_context_t & c, Reader & r, char character)
+{
+    while(peekChar(c, r) == character)
+      c.next++; // ignore white space
+}
+
+template<typename Reader>
+inline __attribute__((always_inline)) void skipWhiteSpace(rtttl_context_t & c, Reader & r)
+{
+  skipCharacters(c, r, ' ');
+}
+
+template<typename Reader>
+int readInteger(rtttl_context_t & c, Reader & r)
+{
+  int value = 0;
+
+  // read first character
+  char character = peekChar(c, r); // peek only at the next character
+  while(isDigitCharacter(character))
+  {
+    character = readChar(c, r); // actually move the read offset
+
+    // saturate long numbers to prevent an overflow. Such numbers are never valid.
+    if (value < 1000)
+      value = (value * 10) + (character - '0');
+    else
+      value = 9999;
+
+    // read next character
+    character = peekChar(c, r); // peek only at the next character
+  }
+
+  return value;
+}
+
+#ifdef ANY_RTTTL_DEBUG
+template<typename Reader>
+void serialPrint(rtttl_context_t & c, Reader & r)
+{
+  // read from a copy of the read offset to leave the context untouched
+  const char * next = c.next;
+
+  // read first character
+  char character = peekChar(c, r);
+  while(character) {
+    Serial.print(character);
+
+    // read next character
+    c.next++;
+    character = peekChar(c, r);
+  }
+  c.next = next;
+}
+#endif
+
+template<typename Reader>
+bool readControlSection(rtttl_context_t & c, Reader & r)
+{
+  int number = 0;
+
+  c.melodyDefaultDur = RTTTL_DEFAULT_DURATION_VALUE;
+  c.melodyDefaultOct = RTTTL_DEFAULT_OCTAVE_VALUE;
+  c.bpm = RTTTL_DEFAULT_BPM_VALUE;
+
+  // format: d=N,o=N,b=NNN:
+  // find the start (skip name, etc)
+
+  // skip melody name
+  char character = peekChar(c, r);
+  while(character != ':') {
+    if (character == '\0')
+      return false; // Parsing error: no control section
+    c.next++;                           // ignore name
+    character = peekChar(c, r);
+  }
+  c.next++;                             // skip ':'
+
+  #if defined(RTTTL_PARSER_STRICT)
+    // get default duration
+    if(peekChar(c, r) == 'd')
+    {
+      skipChar(c, r);                   // skip "d="
+      skipChar(c, r);
+      number = readInteger(c, r);
+      if(isValidDuration((duration_value_t)number))
+        c.melodyDefaultDur = number;
+      skipChar(c, r);                   // skip comma
+    }
+
+    // get default octave
+    if(peekChar(c, r) == 'o')
+    {
+      skipChar(c, r);                   // skip "o="
+      skipChar(c, r);
+      number = readInteger(c, r);
+      if(isValidOctave((octave_value_t)number))
+        c.melodyDefaultOct = number;
+      skipChar(c, r);                   // skip comma
+    }
+
+    // get BPM
+    if(peekChar(c, r) == 'b')
+    {
+      skipChar(c, r);                   // skip "b="
+      skipChar(c, r);
+      number = readInteger(c, r);
+      if(number > 0)
+        c.bpm = number;
+      skipChar(c, r);                   // skip colon
+    }
+  #elif defined(RTTTL_PARSER_RELAXED)
+    character = readLowerCaseChar(c, r);
+
+    while(character != ':') { // read until the end of control section.
+      switch(character) {
+        case 'd': {
+          // get default duration
+          skipChar(c, r);                   // skip "="
+          number = readInteger(c, r);
+          if(isValidDuration((duration_value_t)number))
+            c.melodyDefaultDur = number;
+        }
+        break;
+        case 'o': {
+          // get default octave
+          skipChar(c, r);                   // skip "="
+          number = readInteger(c, r);
+          if(isValidOctave((octave_value_t)number))
+            c.melodyDefaultOct = number;
+        }
+        break;
+        case 'b': {
+          // get BPM
+          skipChar(c, r);                   // skip "="
+          number = readInteger(c, r);
+          if(number > 0)
+            c.bpm = number;
+        }
+        break;
+        case '\0': {
+          // Parsing error: unexpected end of control section
+          return false;
+        }
+        break;
+      }
+
+      // read next
+      character = readLowerCaseChar(c, r);
+    }
+  #endif // RTTTL_PARSER_STRICT / RTTTL_PARSER_RELAXED
+
+  #ifdef ANY_RTTTL_INFO
+  Serial.print("ddur: "); Serial.println(c.melodyDefaultDur, 10);
+  Serial.print("doct: "); Serial.println(c.melodyDefaultOct, 10);
+  Serial.print("bpm: "); Serial.println(c.bpm, 10);
+  #endif
+
+  // BPM usually expresses the number of quarter notes per minute
+  c.wholeNote = (60 * 1000L / c.bpm) * 4;  // this is the time for whole note (in milliseconds)
+
+  #ifdef ANY_RTTTL_INFO
+  Serial.print("wn: "); Serial.println(c.wholeNote, 10);
+  #endif
+
+  return true;
+}
+
+// States of the note parser. The state is the last part of a note that was read.
+// States are bit flags in increasing order of the parts of a note.
+enum note_parser_state_t {
+  NOTE_STATE_DURATION   = 0x01, // before the note letter.
+  NOTE_STATE_LETTER     = 0x02, // after the note letter.
+  NOTE_STATE_SHARP      = 0x04, // after the optional '#' sharp.
+  NOTE_STATE_DOT        = 0x08, // after a '.' dotted note, before the scale (Nokia's Simpsons example).
+  NOTE_STATE_SCALE      = 0x10, // after the scale.
+  NOTE_STATE_SCALE_DOT  = 0x20, // after a '.' dotted note, after the scale (Nokia's original specification).
+};
+
+#if defined(RTTTL_PARSER_STRICT)
+// States of the note parser in which each character class is accepted. Indexed by character_class_t.
+// The strict parser only accepts the parts of a note in the order of the specification.
+static constexpr byte gStrictNoteRules[] = {
+  /* RTTTL_CHAR_OTHER     */ 0,
+  /* RTTTL_CHAR_END       */ 0,
+  /* RTTTL_CHAR_SPACE     */ 0,
+  /* RTTTL_CHAR_DIGIT     */ NOTE_STATE_LETTER | NOTE_STATE_SHARP | NOTE_STATE_DOT,
+  /* RTTTL_CHAR_OCTAVE    */ NOTE_STATE_LETTER | NOTE_STATE_SHARP | NOTE_STATE_DOT,
+  /* RTTTL_CHAR_NOTE      */ 0,
+  /* RTTTL_CHAR_SHARP     */ NOTE_STATE_LETTER,
+  /* RTTTL_CHAR_DOT       */ NOTE_STATE_LETTER | NOTE_STATE_SHARP | NOTE_STATE_DOT | NOTE_STATE_SCALE,
+  /* RTTTL_CHAR_SEPARATOR */ NOTE_STATE_LETTER | NOTE_STATE_SHARP | NOTE_STATE_DOT | NOTE_STATE_SCALE | NOTE_STATE_SCALE_DOT,
+  /* RTTTL_CHAR_SECTION   */ 0,
+  /* RTTTL_CHAR_EQUAL     */ 0,
+};
+#endif
+
+template<typename Reader>
+void readNote(rtttl_context_t & c, Reader & r)
+{
+  int number = 0;
+
+  // Set default values
+  c.duration = c.wholeNote / c.melodyDefaultDur;  // we will check if we are a dotted note later
+  c.scale = c.melodyDefaultOct; // default scale, if unspecified
+  c.noteOffset = 0; // default note is a pause/silence note, if unspecified
+  c.noteDivisor = c.melodyDefaultDur;
+  c.noteDots = 0;
+
+  #if defined(RTTTL_PARSER_RELAXED)
+    skipWhiteSpace(c, r);
+  #endif
+
+  // get note duration, if available
+  number = readInteger(c, r);
+  if(isValidDuration((duration_value_t)number))
+  {
+    c.duration = c.wholeNote / number;
+    c.noteDivisor = (byte)number;
+  }
+
+  byte state = NOTE_STATE_DURATION;
+
+  #if defined(RTTTL_PARSER_STRICT)
+    // the character following the duration is the note letter
+    char character = peekChar(c, r);
+    byte letter = getCharacterInfo(character);
+    if (getCharacterClass(letter) == RTTTL_CHAR_END)
+      return;
+    if (getCharacterClass(letter) == RTTTL_CHAR_NOTE && !isUpperCaseCharacter(character))
+      c.noteOffset = getNoteOffsetFromNoteIndex(getCharacterValue(letter));
+    c.next++;                           // skip note letter. An invalid note letter is played as a pause.
+    state = NOTE_STATE_LETTER;
+  #endif
+
+  // Parse note characters 1 by 1, until note separator or end of buffer.
+  // Each character is dispatched on its class from the gCharacterInfos table.
+  while (true)
+  {
+    byte info = getCharacterInfo(peekChar(c, r));
+    byte type = getCharacterClass(info);
+
+    #if defined(RTTTL_PARSER_STRICT)
+      if ((gStrictNoteRules[type] & state) == 0)
+        break; // not part of this note
+    #elif defined(RTTTL_PARSER_RELAXED)
+      if (type == RTTTL_CHAR_END)
+        break;
+    #endif
+
+    c.next++;
+    switch(type)
+    {
+      case RTTTL_CHAR_NOTE:
+        c.noteOffset = getNoteOffsetFromNoteIndex(getCharacterValue(info));
+        state = NOTE_STATE_LETTER;
+        break;
+      case RTTTL_CHAR_SHARP:
+        // optional '#' sharp
+        c.noteOffset++;
+        state = NOTE_STATE_SHARP;
+        break;
+      case RTTTL_CHAR_DOT:
+        // optional '.' dotted note
+        c.duration += c.duration/2;
+        c.noteDots++;
+        state = (state >= NOTE_STATE_DOT ? NOTE_STATE_SCALE_DOT : NOTE_STATE_DOT);
+        break;
+      case RTTTL_CHAR_DIGIT:
+        #if defined(RTTTL_PARSER_RELAXED)
+          break; // not a valid octave
+        #endif
+        // fall through
+      case RTTTL_CHAR_OCTAVE:
+        // scale
+        c.scale = getCharacterValue(info);
+        state = NOTE_STATE_SCALE;
+        break;
+      case RTTTL_CHAR_SEPARATOR:
+        return; // end of note
+      default:
+        break; // unknown character
+    };
+  }
+}
+
+template<typename Reader>
+void begin(rtttl_context_t & c, Reader & r, byte iPin, const char * iBuffer, uint16_t iMaxLength = RTTTL_UNBOUNDED_LENGTH, const rtttl_output_t * iOutput = NULL)
+{
+  // init context
+  if (!beginContext(c, iOutput))
+    return;
+
+  //init values
+  c.pin = iPin;
+  c.buffer = iBuffer;
+  c.next = iBuffer;
+  c.maxLength = iMaxLength;
+  c.playing = true;
+  setReaderLimit(r, iBuffer, iMaxLength);
+  RTTTL_TRACE(c, RTTTL_TRACE_BEGIN, c.format);
+
+  #ifdef ANY_RTTTL_DEBUG
+  Serial.print("playing: ");
+  serialPrint(c, r);
+  Serial.println();
+  #endif
+
+  //stop current note
+  c.noTone(c.pin);
+
+  if (!readControlSection(c, r))
+  {
+    // Parsing error: unexpected end of control section
+    c.playing = false;
+    c.noTone(c.pin);
+  }
+}
+
+template<typename Reader>
+void nextNote(rtttl_context_t & c, Reader & r)
+{
+  #ifdef ANY_RTTTL_TELEMETRY
+  unsigned long parseStart = getParseTime();
+  readNote(c, r);
+  recordParseTime(c, parseStart);
+  #else
+  readNote(c, r);
+  #endif
+  c.noteIndex++;
+
+  #ifdef ANY_RTTTL_INFO
+  if(c.noteOffset)
+  {
+    Serial.print("Playing: ");
+    Serial.print(c.scale, 10); Serial.print(' ');
+    Serial.print(c.noteOffset, 10); Serial.print(" (");
+    Serial.print(getNoteFrequency(c.scale, c.noteOffset), 10);
+    Serial.print(") ");
+    Serial.println(c.duration, 10);
+  }
+  else
+  {
+    Serial.print("Pausing: ");
+    Serial.println(c.duration, 10);
+  }
+  #endif
+
+  // now play the note
+  playTone(c, getNoteFrequency(c.scale, c.noteOffset), c.duration);
+}
+
+template<typename Reader>
+void play(rtttl_context_t & c, Reader & r)
+{
+  //if done playing the song, return
+  if (!c.playing)
+  {
+    #ifdef ANY_RTTTL_DEBUG
+    Serial.println("done playing...");
+    #endif
+
+    return;
+  }
+
+  //if the song is paused, wait until resume()
+  if (c.paused)
+    return;
+
+  #ifdef ANY_RTTTL_TELEMETRY
+  recordPoll(c);
+  #endif
+
+  //are we still playing a note ?
+  if (isTimeBefore(getTime(), getNextNoteTime(c)))
+  {
+    #ifdef ANY_RTTTL_DEBUG
+    Serial.println("still playing a note...");
+    #endif
+
+    //wait until the note is completed
+    return;
+  }
+
+  //ready to play the next note
+  RTTTL_TRACE_NOTE_END(c);
+  bool end = (peekChar(c, r) == '\0');
+  if (loopBack(c, end))
+    end = false;
+  if (end)
+  {
+    //no more notes. Reached the end of the last note
+
+    #ifdef ANY_RTTTL_DEBUG
+    Serial.println("end of note...");
+    #endif
+
+    c.playing = false;
+    RTTTL_TRACE(c, RTTTL_TRACE_END, c.noteIndex);
+
+    //stop current note (if any)
+    c.noTone(c.pin);
+
+    return; //end of the song
+  }
+  else
+  {
+    //more notes to play...
+
+    #ifdef ANY_RTTTL_DEBUG
+    Serial.println("next note...");
+    #endif
+
+    nextNote(c, r);
+  }
+}
+
+inline void stop(rtttl_context_t & c)
+{
+  //the rest of the melody is not read. play() does nothing once the song is stopped.
+  c.playing = false;
+  c.paused = false;
+  RTTTL_TRACE(c, RTTTL_TRACE_STOP, c.noteIndex);
+
+  //stop current note (if any)
+  if (c.noTone != NULL)
+    c.noTone(c.pin);
+}
+
+}; //detail namespace
+
+/****************************************************************************
+ * Description:
+ *   A non-blocking RTTTL player which reads the melody with the given
+ *   Reader policy. See ram_reader and progmem_reader.
+ *   Any type that provides a `char read(const char * iBuffer)` function
+ *   can be used as a reader for custom sources.
+ ****************************************************************************/
+template<typename Reader>
+class basic_player
+{
+public:
+  basic_player()                            { initContext(context); }
+  explicit basic_player(const Reader & r) : reader(r) { initContext(context); }
+
+  /****************************************************************************
+   * Description:
+   *   Setups the player ready to decode a new RTTTL song.
+   * Parameters:
+   *   iPin:    The pin which is connected to the piezo buffer.
+   *   iBuffer: The string buffer of the RTTTL song.
+   *   iOutput: The output of the song. NULL for the global functions.
+   ****************************************************************************/
+  void begin(byte iPin, const char * iBuffer, const rtttl_output_t * iOutput = NULL)     { detail::begin(context, reader, iPin, iBuffer, RTTTL_UNBOUNDED_LENGTH, iOutput); }
+
+  /****************************************************************************
+   * Description:
+   *   Setups the player ready to decode a new RTTTL song of a known maximum length.
+   *   See nonblocking::begin().
+   * Parameters:
+   *   iPin:       The pin which is connected to the piezo buffer.
+   *   iBuffer:    The string buffer of the RTTTL song.
+   *   iMaxLength: The maximum number of bytes read from iBuffer, at most 65534.
+   *               RTTTL_UNBOUNDED_LENGTH for a song that ends with a '\0' character.
+   *   iOutput:    The output of the song. NULL for the global functions.
+   ****************************************************************************/
+  void begin(byte iPin, const char * iBuffer, uint16_t iMaxLength, const rtttl_output_t * iOutput = NULL) { detail::begin(context, reader, iPin, iBuffer, iMaxLength, iOutput); }
+
+  /****************************************************************************
+   * Description:
+   *   Automatically plays a new note when required.
+   *   This function must constantly be called within the loop() function.
+   ****************************************************************************/
+  void play()                                     { detail::play(context, reader); }
+
+  /****************************************************************************
+   * Description:
+   *   Stops playing the current song.
+   ****************************************************************************/
+  void stop()                                     { detail::stop(context); }
+
+  /****************************************************************************
+   * Description:
+   *   Pauses and resumes the current song. See nonblocking::pause().
+   ****************************************************************************/
+  void pause()                                    { nonblocking::pause(context); }
+  void resume()                                   { nonblocking::resume(context); }
+
+  bool isPaused() const                           { return context.paused; }
+  bool isPlaying() const                          { return context.playing; }
+  bool done() const                               { return !context.playing; }
+
+  rtttl_context_t context;  // the state of the melody.
+  Reader reader;            // the reader used for reading the melody.
+};
+
+typedef basic_player<ram_reader>      ram_player;     // a player for RTTTL melodies stored in RAM.
+typedef basic_player<progmem_reader>  progmem_player; // a player for RTTTL melodies stored in PROGMEM.
+typedef basic_player<progmem_buffered_reader> progmem_buffered_player; // a player for RTTTL melodies stored in PROGMEM, read in blocks.
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_PLAYER_H
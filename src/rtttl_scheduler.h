@@ -0,0 +1,247 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_SCHEDULER_H
+#define RTTTL_SCHEDULER_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Description:
+ *   Plays up to N melodies simultaneously (one per voice) from a single
+ *   poll() call. Each voice owns an rtttl_context_t.
+ *   Playing voices are kept in a min-heap ordered by the time of their
+ *   next note. A poll() call reads the time once and only services the
+ *   voices that are due. An idle poll() only checks the top of the heap.
+ ****************************************************************************/
+template<uint8_t N>
+class scheduler
+{
+public:
+  scheduler() : mCount(0)
+  {
+    for(uint8_t i=0; i<N; i++)
+    {
+      initContext(mContexts[i]);
+      mPositions[i] = INVALID_POSITION;
+    }
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Returns the context of the given voice.
+   *   The context can be used with any nonblocking::begin function.
+   *   Call schedule() after starting the voice.
+   ****************************************************************************/
+  rtttl_context_t & context(uint8_t iVoice) { return mContexts[iVoice]; }
+
+  /****************************************************************************
+   * Description:
+   *   Starts playing a melody on the given voice.
+   *   Accepts the same arguments as nonblocking::begin() without the context.
+   ****************************************************************************/
+  template<typename... Args>
+  void begin(uint8_t iVoice, Args... args)
+  {
+    nonblocking::begin(mContexts[iVoice], args...);
+    schedule(iVoice);
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Adds a voice that was started with one of the nonblocking::begin
+   *   functions to the scheduler. If the voice is already scheduled,
+   *   its position is updated.
+   ****************************************************************************/
+  void schedule(uint8_t iVoice)
+  {
+    if (iVoice >= N || !mContexts[iVoice].playing || mContexts[iVoice].paused)
+      return;
+
+    uint8_t pos = mPositions[iVoice];
+    if (pos == INVALID_POSITION)
+    {
+      pos = mCount++;
+      mHeap[pos] = iVoice;
+      mPositions[iVoice] = pos;
+    }
+    siftDown(siftUp(pos));
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Stops the melody of the given voice.
+   ****************************************************************************/
+  void stop(uint8_t iVoice)
+  {
+    if (iVoice >= N)
+      return;
+    nonblocking::stop(mContexts[iVoice]);
+    remove(iVoice);
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Pauses the melody of the given voice. The voice is removed from
+   *   the scheduler until resume() is called.
+   ****************************************************************************/
+  void pause(uint8_t iVoice)
+  {
+    if (iVoice >= N)
+      return;
+    nonblocking::pause(mContexts[iVoice]);
+    remove(iVoice);
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Resumes the paused melody of the given voice.
+   ****************************************************************************/
+  void resume(uint8_t iVoice)
+  {
+    if (iVoice >= N)
+      return;
+    nonblocking::resume(mContexts[iVoice]);
+    schedule(iVoice);
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Plays the next note of all voices that are due.
+   *   Must be called as often as possible.
+   ****************************************************************************/
+  void poll()
+  {
+    if (mCount == 0)
+      return;
+
+    unsigned long now = detail::getTime();
+    while (mCount > 0)
+    {
+      uint8_t voice = mHeap[0];
+      rtttl_context_t & c = mContexts[voice];
+      if (c.playing && detail::isTimeBefore(now, detail::getNextNoteTime(c)))
+        return; // the earliest voice is not due yet
+
+      nonblocking::play(c);
+
+      if (c.playing && !c.paused)
+        siftDown(0); // move the voice at its next deadline
+      else
+        remove(voice); // end of the melody or paused voice
+    }
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Returns the time until poll() has something to do: the time until
+   *   the end of the earliest note of all voices. See nonblocking::millisUntilNextEvent().
+   *   Returns RTTTL_NO_EVENT if no voice is scheduled.
+   ****************************************************************************/
+  unsigned long millisUntilNextEvent() const
+  {
+    if (mCount == 0)
+      return RTTTL_NO_EVENT;
+    return nonblocking::millisUntilNextEvent(mContexts[mHeap[0]]);
+  }
+
+  /****************************************************************************
+   * Description:
+   *   Returns true if the given voice is playing a melody.
+   ****************************************************************************/
+  bool isPlaying(uint8_t iVoice) const { return (iVoice < N && mContexts[iVoice].playing); }
+
+  /****************************************************************************
+   * Description:
+   *   Returns true if all voices are done playing.
+   ****************************************************************************/
+  bool done() const { return (mCount == 0); }
+
+  /****************************************************************************
+   * Description:
+   *   Returns the number of voices that are currently scheduled.
+   ****************************************************************************/
+  uint8_t count() const { return mCount; }
+
+private:
+  static const uint8_t INVALID_POSITION = 0xFF;
+
+  bool isBefore(uint8_t iPosA, uint8_t iPosB) const
+  {
+    return detail::isTimeBefore(detail::getNextNoteTime(mContexts[mHeap[iPosA]]), detail::getNextNoteTime(mContexts[mHeap[iPosB]]));
+  }
+
+  void swap(uint8_t iPosA, uint8_t iPosB)
+  {
+    uint8_t voice = mHeap[iPosA];
+    mHeap[iPosA] = mHeap[iPosB];
+    mHeap[iPosB] = voice;
+    mPositions[mHeap[iPosA]] = iPosA;
+    mPositions[mHeap[iPosB]] = iPosB;
+  }
+
+  uint8_t siftUp(uint8_t iPos)
+  {
+    while (iPos > 0)
+    {
+      uint8_t parent = (iPos - 1) / 2;
+      if (!isBefore(iPos, parent))
+        break;
+      swap(iPos, parent);
+      iPos = parent;
+    }
+    return iPos;
+  }
+
+  uint8_t siftDown(uint8_t iPos)
+  {
+    while (true)
+    {
+      uint8_t first = iPos;
+      uint8_t left = 2*iPos + 1;
+      uint8_t right = left + 1;
+      if (left < mCount && isBefore(left, first))
+        first = left;
+      if (right < mCount && isBefore(right, first))
+        first = right;
+      if (first == iPos)
+        break;
+      swap(iPos, first);
+      iPos = first;
+    }
+    return iPos;
+  }
+
+  void remove(uint8_t iVoice)
+  {
+    uint8_t pos = mPositions[iVoice];
+    if (pos == INVALID_POSITION)
+      return;
+
+    // replace the removed voice by the last voice of the heap
+    mCount--;
+    if (pos != mCount)
+    {
+      swap(pos, mCount);
+      siftDown(siftUp(pos));
+    }
+    mPositions[iVoice] = INVALID_POSITION;
+  }
+
+  rtttl_context_t mContexts[N];
+  uint8_t mHeap[N];       // voices ordered by nextNoteMs (min-heap).
+  uint8_t mPositions[N];  // position of each voice in mHeap. INVALID_POSITION if not scheduled.
+  uint8_t mCount;         // number of voices in mHeap.
+};
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_SCHEDULER_H
@@ -0,0 +1,299 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_seek.h"
+
+namespace anyrtttl
+{
+
+namespace detail
+{
+
+/****************************************************************************
+ * Description:
+ *   Moves the given context back to the first note of its melody.
+ ****************************************************************************/
+static bool rewind(rtttl_context_t & c)
+{
+  if (c.format == RTTTL_FORMAT_STREAM)
+    return false; // the notes of a stream are not kept once played
+  c.noteIndex = 0;
+  if (c.format != RTTTL_FORMAT_TEXT)
+    return true;
+
+  if (c.buffer == NULL)
+    return false;
+  c.next = c.buffer;
+  function_reader r = { c.getCharPtr };
+  return readControlSection(c, r);
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the given context has a note left to play.
+ ****************************************************************************/
+static bool hasNote(rtttl_context_t & c)
+{
+  if (c.format != RTTTL_FORMAT_TEXT)
+    return (c.noteIndex < c.notesCount);
+
+  function_reader r = { c.getCharPtr };
+  return (peekChar(c, r) != '\0');
+}
+
+/****************************************************************************
+ * Description:
+ *   Reads the next note of the given context without playing it.
+ *   Assumes hasNote() is true.
+ * Returns:
+ *   Returns the time in milliseconds nonblocking::play() waits for the note.
+ ****************************************************************************/
+static uint32_t skipNote(rtttl_context_t & c)
+{
+  uint16_t frequency;
+  if (c.format == RTTTL_FORMAT_TEXT)
+  {
+    function_reader r = { c.getCharPtr };
+    readNote(c, r);
+    frequency = getNoteFrequency(c.scale, c.noteOffset);
+  }
+  else if (c.format == RTTTL_FORMAT_EVENTS)
+  {
+    const rtttl_note_event_t & e = c.events[c.noteIndex];
+    c.duration = e.duration;
+    frequency = e.frequency;
+  }
+  else
+  {
+    decodeBinaryNote(c);
+    frequency = getNoteFrequency(c.scale, c.noteOffset);
+  }
+  c.noteIndex++;
+
+  // tones are followed by 1 ms of silence. See playTone().
+  return (frequency != NOTE_SILENT ? c.duration + 1 : c.duration);
+}
+
+static uint16_t getOffset(const rtttl_context_t & c)
+{
+  if (c.format == RTTTL_FORMAT_TEXT)
+    return (uint16_t)(c.next - c.buffer);
+  return c.noteIndex;
+}
+
+static void setOffset(rtttl_context_t & c, uint16_t iOffset, uint16_t iNoteIndex)
+{
+  if (c.format == RTTTL_FORMAT_TEXT)
+    c.next = c.buffer + iOffset;
+  c.noteIndex = iNoteIndex;
+}
+
+static void readSeekPoint(const rtttl_seek_point_t * iPoints, uint16_t iIndex, GetCharFuncPtr iGetCharFuncPtr, rtttl_seek_point_t & oPoint)
+{
+  const char * src = (const char *)&iPoints[iIndex];
+  char * dst = (char *)&oPoint;
+  for(byte i=0; i<sizeof(rtttl_seek_point_t); i++)
+    dst[i] = iGetCharFuncPtr(src + i);
+}
+
+/****************************************************************************
+ * Description:
+ *   Binary search of the last checkpoint at or before the given note or time.
+ * Returns:
+ *   Returns true if a checkpoint was found.
+ ****************************************************************************/
+static bool findSeekPoint(const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr, uint32_t iValue, bool iByTime, rtttl_seek_point_t & oPoint)
+{
+  if (iPoints == NULL)
+    return false;
+
+  bool found = false;
+  uint16_t first = 0;
+  uint16_t last = iPointsCount;
+  while (first < last)
+  {
+    uint16_t middle = first + (last - first) / 2;
+    rtttl_seek_point_t p;
+    readSeekPoint(iPoints, middle, iGetCharFuncPtr, p);
+    uint32_t value = (iByTime ? p.timeMs : p.noteIndex);
+    if (value <= iValue)
+    {
+      oPoint = p;
+      found = true;
+      first = middle + 1;
+    }
+    else
+      last = middle;
+  }
+  return found;
+}
+
+/****************************************************************************
+ * Description:
+ *   Moves a copy of the given context to the nearest checkpoint before the
+ *   given note or time.
+ ****************************************************************************/
+static bool seekToCheckpoint(rtttl_context_t & c, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr, uint32_t iValue, bool iByTime, rtttl_seek_point_t & oPoint)
+{
+  if ((c.format == RTTTL_FORMAT_TEXT && c.buffer == NULL) || c.format == RTTTL_FORMAT_STREAM)
+    return false;
+
+  if (findSeekPoint(iPoints, iPointsCount, iGetCharFuncPtr, iValue, iByTime, oPoint))
+  {
+    setOffset(c, oPoint.offset, oPoint.noteIndex);
+    return true;
+  }
+
+  oPoint.offset = 0;
+  oPoint.noteIndex = 0;
+  oPoint.timeMs = 0;
+  return rewind(c);
+}
+
+/****************************************************************************
+ * Description:
+ *   Replaces the given context by the seeked context.
+ *   The next note is played at the next call to play().
+ ****************************************************************************/
+static void jump(rtttl_context_t & c, const rtttl_context_t & iSeeked)
+{
+  c = iSeeked;
+  c.playing = true;
+  c.hasDeadline = false;
+  c.tempoRemainder = 0;
+  c.remainingTime = 0;
+  if (gTimingMode == RTTTL_TIMING_MICROS)
+    c.nextNoteUs = _micros();
+  else
+    c.nextNoteMs = _millis();
+
+  //stop current note
+  c.noTone(c.pin);
+}
+
+}; //detail namespace
+
+uint16_t buildSeekIndex(const rtttl_context_t & c, uint16_t iInterval, rtttl_seek_point_t * oPoints, uint16_t iMaxPoints)
+{
+  if (iInterval == 0)
+    return 0;
+
+  // Use a copy of the context for parsing the melody.
+  rtttl_context_t s = c;
+  if (!detail::rewind(s))
+    return 0;
+
+  uint16_t count = 0;
+  uint16_t noteIndex = 0;
+  uint32_t timeMs = 0;
+  while (detail::hasNote(s))
+  {
+    if (noteIndex % iInterval == 0)
+    {
+      if (oPoints != NULL)
+      {
+        if (count >= iMaxPoints)
+          break; // output buffer is full
+
+        rtttl_seek_point_t & p = oPoints[count];
+        p.offset = detail::getOffset(s);
+        p.noteIndex = noteIndex;
+        p.timeMs = timeMs;
+      }
+      count++;
+    }
+
+    timeMs += detail::skipNote(s);
+    noteIndex++;
+  }
+
+  return count;
+}
+
+namespace nonblocking
+{
+
+bool seekToNote(rtttl_context_t & c, uint16_t iNoteIndex, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr)
+{
+  if (!detail::isFunctionsAssigned(c))
+    return false;
+
+  rtttl_context_t s = c;
+  rtttl_seek_point_t p;
+  if (!detail::seekToCheckpoint(s, iPoints, iPointsCount, iGetCharFuncPtr, iNoteIndex, false, p))
+    return false;
+
+  // parse the notes between the checkpoint and the requested note
+  for(uint16_t i=p.noteIndex; i<iNoteIndex; i++)
+  {
+    if (!detail::hasNote(s))
+      return false;
+    detail::skipNote(s);
+  }
+  if (!detail::hasNote(s))
+    return false;
+
+  detail::jump(c, s);
+  return true;
+}
+
+bool seekToTime(rtttl_context_t & c, uint32_t iTimeMs, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr)
+{
+  if (!detail::isFunctionsAssigned(c))
+    return false;
+
+  rtttl_context_t s = c;
+  rtttl_seek_point_t p;
+  if (!detail::seekToCheckpoint(s, iPoints, iPointsCount, iGetCharFuncPtr, iTimeMs, true, p))
+    return false;
+
+  // parse the notes until the note playing at the requested time
+  uint32_t timeMs = p.timeMs;
+  while (detail::hasNote(s))
+  {
+    uint16_t offset = detail::getOffset(s);
+    timeMs += detail::skipNote(s);
+    if (timeMs > iTimeMs)
+    {
+      detail::setOffset(s, offset, s.noteIndex - 1); // go back to the start of the note
+      detail::jump(c, s);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool setLoop(rtttl_context_t & c, uint16_t iRepeatCount, uint16_t iStartNote, uint16_t iEndNote)
+{
+  if (iEndNote <= iStartNote)
+    return false;
+
+  // find the first note of the loop
+  rtttl_context_t s = c;
+  if (!detail::rewind(s))
+    return false;
+  for(uint16_t i=0; i<iStartNote; i++)
+  {
+    if (!detail::hasNote(s))
+      return false;
+    detail::skipNote(s);
+  }
+  if (!detail::hasNote(s))
+    return false;
+
+  c.loopStartOffset = detail::getOffset(s);
+  c.loopStartNote = iStartNote;
+  c.loopEndNote = iEndNote;
+  c.loopCount = iRepeatCount;
+  return true;
+}
+
+}; //nonblocking namespace
+
+}; //anyrtttl namespace
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_SEEK_H
+#define RTTTL_SEEK_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines a checkpoint of a seek index.
+ *   A seek index is an array of checkpoints taken every N notes of a melody.
+ *   See buildSeekIndex().
+ ****************************************************************************/
+typedef struct rtttl_seek_point_t {
+  uint16_t offset;            // position of the note in the melody. Offset in bytes from the start of a text melody or index of the note for other formats.
+  uint16_t noteIndex;         // index of the note in the melody.
+  uint32_t timeMs;            // time of the start of the note in milliseconds from the start of the melody.
+} rtttl_seek_point_t;
+
+/****************************************************************************
+ * Description:
+ *   Builds a seek index of the melody of the given context.
+ *   A checkpoint is stored every iInterval notes, starting with the first note.
+ *   The index only needs to be built once per melody. It can be copied
+ *   to PROGMEM to save RAM. The context is not modified.
+ *   Times are computed with the millisecond timing of nonblocking::play().
+ * Parameters:
+ *   c:           An RTTTL context that was started with one of the nonblocking::begin functions.
+ *   iInterval:   The number of notes between checkpoints.
+ *   oPoints:     The output array of checkpoints. Can be NULL to only count the checkpoints.
+ *   iMaxPoints:  The maximum number of checkpoints that can be written to oPoints.
+ * Returns:
+ *   Returns the number of checkpoints written to oPoints.
+ *   If oPoints is NULL, returns the number of checkpoints required for the melody.
+ ****************************************************************************/
+uint16_t buildSeekIndex(const rtttl_context_t & c, uint16_t iInterval, rtttl_seek_point_t * oPoints, uint16_t iMaxPoints);
+
+namespace nonblocking
+{
+
+/****************************************************************************
+ * Description:
+ *   Moves the melody to the given note. The note is played at the next call to play().
+ *   Jumps to the nearest checkpoint of the seek index before the note and
+ *   parses the remaining notes without playing them.
+ *   Without a seek index, the melody is parsed from the first note.
+ * Parameters:
+ *   c:               An RTTTL context that was started with one of the nonblocking::begin functions.
+ *   iNoteIndex:      The index of the note to play next.
+ *   iPoints:         The seek index of the melody. See buildSeekIndex(). Can be NULL.
+ *   iPointsCount:    The number of checkpoints in iPoints.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the seek index.
+ * Returns:
+ *   Returns true if the melody was moved and false if the note is past the end of the melody.
+ ****************************************************************************/
+bool seekToNote(rtttl_context_t & c, uint16_t iNoteIndex, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr);
+
+/****************************************************************************
+ * Description:
+ *   Moves the melody to the note playing at the given time.
+ *   The note is played from its start at the next call to play().
+ *   See seekToNote() for details.
+ * Parameters:
+ *   c:               An RTTTL context that was started with one of the nonblocking::begin functions.
+ *   iTimeMs:         The time in milliseconds from the start of the melody.
+ *   iPoints:         The seek index of the melody. See buildSeekIndex(). Can be NULL.
+ *   iPointsCount:    The number of checkpoints in iPoints.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the seek index.
+ * Returns:
+ *   Returns true if the melody was moved and false if the time is past the end of the melody.
+ ****************************************************************************/
+bool seekToTime(rtttl_context_t & c, uint32_t iTimeMs, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount, GetCharFuncPtr iGetCharFuncPtr);
+
+/****************************************************************************
+ * Description:
+ *   Repeats a range of notes of the melody.
+ *   The position of the first note of the loop and the control section of
+ *   the melody are kept in the context. Going back to the start of the loop
+ *   costs no more than reading a note and adds no gap between notes.
+ *   Call after one of the nonblocking::begin functions. The melody plays
+ *   normally until the end of the loop, then repeats the loop iRepeatCount
+ *   times and plays the rest of the melody.
+ * Parameters:
+ *   c:             An RTTTL context that was started with one of the nonblocking::begin functions.
+ *   iRepeatCount:  The number of times the loop is repeated. Use RTTTL_LOOP_FOREVER to repeat forever. Use 0 to disable the loop.
+ *   iStartNote:    The index of the first note of the loop.
+ *   iEndNote:      The index of the note following the last note of the loop. Use RTTTL_LOOP_END to loop at the end of the melody.
+ * Returns:
+ *   Returns true if the loop is set and false if the notes are not in the melody.
+ ****************************************************************************/
+bool setLoop(rtttl_context_t & c, uint16_t iRepeatCount, uint16_t iStartNote, uint16_t iEndNote);
+
+// helper functions
+inline bool setLoop(rtttl_context_t & c, uint16_t iRepeatCount)                                                                    { return setLoop(c, iRepeatCount, 0, RTTTL_LOOP_END); }
+inline bool seekToNote(rtttl_context_t & c, uint16_t iNoteIndex)                                                                  { return seekToNote(c, iNoteIndex, NULL, 0, &anyrtttl::readCharMem); }
+inline bool seekToNote(rtttl_context_t & c, uint16_t iNoteIndex, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount)       { return seekToNote(c, iNoteIndex, iPoints, iPointsCount, &anyrtttl::readCharMem); }
+inline bool seekToNote_P(rtttl_context_t & c, uint16_t iNoteIndex, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount)     { return seekToNote(c, iNoteIndex, iPoints, iPointsCount, &anyrtttl::readCharPgm); }
+inline bool seekToTime(rtttl_context_t & c, uint32_t iTimeMs)                                                                     { return seekToTime(c, iTimeMs, NULL, 0, &anyrtttl::readCharMem); }
+inline bool seekToTime(rtttl_context_t & c, uint32_t iTimeMs, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount)          { return seekToTime(c, iTimeMs, iPoints, iPointsCount, &anyrtttl::readCharMem); }
+inline bool seekToTime_P(rtttl_context_t & c, uint32_t iTimeMs, const rtttl_seek_point_t * iPoints, uint16_t iPointsCount)        { return seekToTime(c, iTimeMs, iPoints, iPointsCount, &anyrtttl::readCharPgm); }
+
+}; //nonblocking namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_SEEK_H
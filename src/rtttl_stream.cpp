@@ -0,0 +1,304 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_stream.h"
+
+namespace anyrtttl
+{
+
+namespace stream
+{
+
+// Parts of a melody. The state is the part of the melody being received.
+enum stream_state_t {
+  STREAM_STATE_NAME = 0,  // before the first ':'.
+  STREAM_STATE_CONTROL,   // after the first ':', before the second ':'.
+  STREAM_STATE_NOTES,     // after the second ':'.
+  STREAM_STATE_END,       // after the end of the melody.
+  STREAM_STATE_ERROR,     // the melody cannot be parsed.
+};
+
+static_assert((RTTTL_STREAM_QUEUE_SIZE & (RTTTL_STREAM_QUEUE_SIZE - 1)) == 0, "RTTTL_STREAM_QUEUE_SIZE must be a power of 2");
+
+static void setError(rtttl_stream_t & s)
+{
+  s.state = STREAM_STATE_ERROR;
+  s.tokenLength = 0;
+  s.ended = true; // play the notes in the queue and end the melody
+}
+
+static bool isQueueFull(const rtttl_stream_t & s)
+{
+  return ((byte)(s.writeCount - s.readCount) >= RTTTL_STREAM_QUEUE_SIZE);
+}
+
+/****************************************************************************
+ * Description:
+ *   Adds a character to the current token.
+ *   The last character of the token is reserved for the terminating '\0'.
+ ****************************************************************************/
+static bool append(rtttl_stream_t & s, char iCharacter)
+{
+  if (s.tokenLength + 1 >= RTTTL_STREAM_TOKEN_SIZE)
+  {
+    setError(s);
+    return false;
+  }
+  s.token[s.tokenLength++] = iCharacter;
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the current token only contains white spaces.
+ ****************************************************************************/
+static bool isBlankToken(const rtttl_stream_t & s)
+{
+  for(byte i=0; i<s.tokenLength; i++)
+  {
+    if (getCharacterClass(getCharacterInfo(s.token[i])) != RTTTL_CHAR_SPACE)
+      return false;
+  }
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Parses the control section stored in the current token.
+ *   The token starts and ends with ':' as expected by readControlSection().
+ ****************************************************************************/
+static void parseControlSection(rtttl_stream_t & s)
+{
+  s.token[s.tokenLength] = '\0';
+
+  rtttl_context_t c;
+  initContext(c);
+  c.buffer = s.token;
+  c.next = s.token;
+  ram_reader r;
+  if (!detail::readControlSection(c, r))
+  {
+    setError(s);
+    return;
+  }
+
+  s.melodyDefaultDur = c.melodyDefaultDur;
+  s.melodyDefaultOct = c.melodyDefaultOct;
+  s.bpm = c.bpm;
+  s.wholeNote = c.wholeNote;
+  s.state = STREAM_STATE_NOTES;
+  s.tokenLength = 0;
+}
+
+/****************************************************************************
+ * Description:
+ *   Parses the note stored in the current token and adds it to the queue.
+ *   Assumes the queue is not full.
+ ****************************************************************************/
+static void parseNote(rtttl_stream_t & s)
+{
+  s.token[s.tokenLength] = '\0';
+
+  rtttl_context_t c;
+  initContext(c);
+  c.melodyDefaultDur = s.melodyDefaultDur;
+  c.melodyDefaultOct = s.melodyDefaultOct;
+  c.bpm = s.bpm;
+  c.wholeNote = s.wholeNote;
+  c.buffer = s.token;
+  c.next = s.token;
+  ram_reader r;
+  detail::readNote(c, r);
+
+  rtttl_stream_note_t n;
+  n.duration = c.duration;
+  n.scale = c.scale;
+  n.noteOffset = c.noteOffset;
+  n.noteDivisor = c.noteDivisor;
+  n.noteDots = c.noteDots;
+  detail::pushStreamNote(s, n);
+  s.tokenLength = 0;
+}
+
+void init(rtttl_stream_t & s)
+{
+  s.state = STREAM_STATE_NAME;
+  s.tokenLength = 0;
+  s.melodyDefaultDur = RTTTL_DEFAULT_DURATION_VALUE;
+  s.melodyDefaultOct = RTTTL_DEFAULT_OCTAVE_VALUE;
+  s.bpm = RTTTL_DEFAULT_BPM_VALUE;
+  s.wholeNote = 0;
+  s.writeCount = 0;
+  s.readCount = 0;
+  s.ended = false;
+}
+
+uint16_t feed(rtttl_stream_t & s, const char * iBuffer, uint16_t iSize)
+{
+  for(uint16_t i=0; i<iSize; i++)
+  {
+    char character = iBuffer[i];
+    if (character == '\0')
+    {
+      if (!end(s))
+        return i; // the last note does not fit in the queue
+      continue;
+    }
+
+    switch(s.state)
+    {
+      case STREAM_STATE_NAME:
+        // skip melody name
+        if (character == ':')
+        {
+          s.state = STREAM_STATE_CONTROL;
+          append(s, character);
+        }
+        break;
+      case STREAM_STATE_CONTROL:
+        if (append(s, character) && character == ':')
+          parseControlSection(s);
+        break;
+      case STREAM_STATE_NOTES:
+        if (character == ',')
+        {
+          if (isQueueFull(s))
+            return i; // wait until a note is played
+          parseNote(s);
+        }
+        else
+          append(s, character);
+        break;
+      default:
+        break; // ignore characters after the end of the melody
+    };
+  }
+
+  return iSize;
+}
+
+bool end(rtttl_stream_t & s)
+{
+  if (s.state == STREAM_STATE_NAME || s.state == STREAM_STATE_CONTROL)
+  {
+    // Parsing error: unexpected end of control section
+    setError(s);
+    return true;
+  }
+
+  if (s.state == STREAM_STATE_NOTES)
+  {
+    if (!isBlankToken(s))
+    {
+      if (isQueueFull(s))
+        return false;
+      parseNote(s);
+    }
+    detail::endStream(s);
+  }
+
+  return true;
+}
+
+byte available(const rtttl_stream_t & s)
+{
+  return (byte)(s.writeCount - s.readCount);
+}
+
+bool isEnded(const rtttl_stream_t & s)
+{
+  return s.ended;
+}
+
+bool hasError(const rtttl_stream_t & s)
+{
+  return (s.state == STREAM_STATE_ERROR);
+}
+
+}; //stream namespace
+
+namespace detail
+{
+
+bool pushStreamNote(rtttl_stream_t & s, const rtttl_stream_note_t & iNote)
+{
+  if (stream::isQueueFull(s))
+    return false;
+
+  s.notes[s.writeCount & (RTTTL_STREAM_QUEUE_SIZE - 1)] = iNote;
+  s.writeCount++; // publish the note once it is written
+  return true;
+}
+
+void endStream(rtttl_stream_t & s)
+{
+  s.state = stream::STREAM_STATE_END;
+  s.tokenLength = 0;
+  s.ended = true; // set after the last note is in the queue
+}
+
+bool waitStreamNote(rtttl_context_t & c)
+{
+  // The end flag must be read before the queue. See stream::end().
+  bool ended = stream::isEnded(*c.stream);
+  if (ended || stream::available(*c.stream) > 0)
+    return false;
+
+  // Check the stream again in 1 ms.
+  // The next note starts when it is received instead of the end of the previous note.
+  unsigned long now = getTime();
+  if (gTimingMode == RTTTL_TIMING_MICROS)
+    c.nextNoteUs = now + 1000;
+  else
+    c.nextNoteMs = now + 1;
+  c.hasDeadline = false;
+  return true;
+}
+
+void playStreamNote(rtttl_context_t & c)
+{
+  rtttl_stream_t & s = *c.stream;
+  const rtttl_stream_note_t & n = s.notes[s.readCount & (RTTTL_STREAM_QUEUE_SIZE - 1)];
+  c.duration = n.duration;
+  c.scale = n.scale;
+  c.noteOffset = n.noteOffset;
+  c.noteDivisor = n.noteDivisor;
+  c.noteDots = n.noteDots;
+  c.bpm = s.bpm;
+  c.wholeNote = s.wholeNote;
+  s.readCount++; // release the note once it is read
+
+  playTone(c, getNoteFrequency(c.scale, c.noteOffset), c.duration);
+}
+
+}; //detail namespace
+
+namespace nonblocking
+{
+
+void beginStream(rtttl_context_t & c, byte iPin, rtttl_stream_t & s, const rtttl_output_t * iOutput)
+{
+  // init context
+  if (!detail::beginContext(c, iOutput))
+    return;
+
+  //init values
+  c.pin = iPin;
+  c.format = RTTTL_FORMAT_STREAM;
+  c.stream = &s;
+  c.playing = true;
+  RTTTL_TRACE(c, RTTTL_TRACE_BEGIN, c.format);
+
+  //stop current note
+  c.noTone(c.pin);
+}
+
+}; //nonblocking namespace
+
+}; //anyrtttl namespace
@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_STREAM_H
+#define RTTTL_STREAM_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+static constexpr byte RTTTL_STREAM_TOKEN_SIZE = 24; // maximum length of the control section or of a note of a streamed melody, in characters.
+static constexpr byte RTTTL_STREAM_QUEUE_SIZE = 8;  // maximum number of parsed notes waiting to be played. Must be a power of 2.
+
+/****************************************************************************
+ * Description:
+ *   Defines a parsed note of a streamed melody.
+ ****************************************************************************/
+typedef struct rtttl_stream_note_t {
+  duration_value_t duration;  // duration of the note in milliseconds.
+  octave_value_t scale;       // octave of the note.
+  byte noteOffset;            // offset of the note within the octave. 0 is a pause.
+  byte noteDivisor;           // duration of the note (4 for a quarter note).
+  byte noteDots;              // number of dots of the note.
+} rtttl_stream_note_t;
+
+/****************************************************************************
+ * Description:
+ *   Defines the state of a push parser for RTTTL melodies received in chunks.
+ *   See the stream namespace.
+ ****************************************************************************/
+typedef struct rtttl_stream_t {
+  byte state;                 // part of the melody being received. See stream_state_t.
+  byte tokenLength;           // number of characters in token.
+  char token[RTTTL_STREAM_TOKEN_SIZE]; // characters of the control section or of the note being received.
+  byte melodyDefaultDur;      // default duration of notes in the melody.
+  byte melodyDefaultOct;      // default  octave  of notes in the melody.
+  bpm_value_t bpm;            // melody beats per minutes.
+  duration_value_t wholeNote; // time for whole note in milliseconds.
+  rtttl_stream_note_t notes[RTTTL_STREAM_QUEUE_SIZE]; // parsed notes waiting to be played.
+  volatile byte writeCount;   // number of notes added to the queue. Only modified by the parser.
+  volatile byte readCount;    // number of notes removed from the queue. Only modified by the player.
+  volatile bool ended;        // true when the end of the melody was received and all notes are in the queue.
+} rtttl_stream_t;
+
+/****************************************************************************
+ * Stream API
+ *
+ * A push parser for RTTTL text melodies received from UART, TCP, BLE, etc.
+ * The application feeds the characters of the melody as they arrive,
+ * in chunks of any size. The parser state is kept between chunks and a note
+ * is added to a queue as soon as its separator is received. Playback can
+ * start before the rest of the melody is received and the parser never
+ * waits for input.
+ *
+ * The queue is safe for one producer and one consumer: the melody can be
+ * fed from loop() while it is played from a timer interrupt.
+ ****************************************************************************/
+namespace stream
+{
+
+/****************************************************************************
+ * Description:
+ *   Initializes a stream ready to receive a new melody.
+ * Parameters:
+ *   s:       The stream to initialize.
+ ****************************************************************************/
+void init(rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Feeds characters of the melody to the parser.
+ *   A '\0' character is the end of the melody. See end().
+ *   Stops when the queue is full. The characters that were not consumed
+ *   must be fed again once notes are played.
+ * Parameters:
+ *   s:       The stream of the melody.
+ *   iBuffer: The received characters.
+ *   iSize:   The number of characters in iBuffer.
+ * Returns:
+ *   Returns the number of characters consumed by the parser.
+ ****************************************************************************/
+uint16_t feed(rtttl_stream_t & s, const char * iBuffer, uint16_t iSize);
+
+/****************************************************************************
+ * Description:
+ *   Marks the end of the melody. The last note is added to the queue.
+ * Parameters:
+ *   s:       The stream of the melody.
+ * Returns:
+ *   Returns true if the end of melody is accepted and false if the queue
+ *   is full. Call again once notes are played.
+ ****************************************************************************/
+bool end(rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of parsed notes waiting to be played.
+ ****************************************************************************/
+byte available(const rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the end of the melody was received.
+ ****************************************************************************/
+bool isEnded(const rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the melody cannot be parsed. A token longer than
+ *   RTTTL_STREAM_TOKEN_SIZE or an invalid control section stops the parser.
+ *   The notes already in the queue are played and the melody ends.
+ ****************************************************************************/
+bool hasError(const rtttl_stream_t & s);
+
+// helper functions
+inline bool feed(rtttl_stream_t & s, char iCharacter)       { return (feed(s, &iCharacter, 1) == 1); }
+inline uint16_t feed(rtttl_stream_t & s, const char * iBuffer) { return feed(s, iBuffer, (uint16_t)strlen(iBuffer)); }
+
+}; //stream namespace
+
+namespace detail
+{
+
+/****************************************************************************
+ * Description:
+ *   Adds a parsed note to the queue of a stream.
+ *   Used by the parsers that fill a stream.
+ * Returns:
+ *   Returns true if the note is added and false if the queue is full.
+ ****************************************************************************/
+bool pushStreamNote(rtttl_stream_t & s, const rtttl_stream_note_t & iNote);
+
+/****************************************************************************
+ * Description:
+ *   Marks the end of the melody of a stream once its last note is queued.
+ ****************************************************************************/
+void endStream(rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the stream of the given context has no note to play
+ *   and the end of the melody is not received yet.
+ *   Schedules the next check of the stream 1 ms later.
+ ****************************************************************************/
+bool waitStreamNote(rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Removes the next note from the stream of the given context and plays it.
+ *   Assumes stream::available() is not 0.
+ ****************************************************************************/
+void playStreamNote(rtttl_context_t & c);
+
+}; //detail namespace
+
+namespace nonblocking
+{
+
+/****************************************************************************
+ * Description:
+ *   Setups the AnyRtttl library for non-blocking mode and ready to
+ *   play a melody from a stream. The stream does not need to contain
+ *   any character yet. Notes are played as soon as they are parsed.
+ *   When the queue of the stream is empty, play() waits for the next note.
+ *   The melody is done when all notes are played after stream::end().
+ *   Streamed melodies cannot be seeked or looped.
+ * Parameters:
+ *   c:       An RTTTL context to keep track of the melody's state.
+ *   iPin:    The pin which is connected to the piezo buffer.
+ *   s:       The stream of the melody. Must remain valid until the song is done playing.
+ *   iOutput: The output of the melody. NULL for the global functions.
+ ****************************************************************************/
+void beginStream(rtttl_context_t & c, byte iPin, rtttl_stream_t & s, const rtttl_output_t * iOutput = NULL);
+
+/****************************************************************************
+ * Legacy API functions
+ ****************************************************************************/
+inline void beginStream(byte iPin, rtttl_stream_t & s)  { beginStream(anyrtttl::gGlobalContext, iPin, s); }
+
+}; //nonblocking namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_STREAM_H
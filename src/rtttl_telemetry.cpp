@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_telemetry.h"
+
+namespace anyrtttl
+{
+
+#ifdef ANY_RTTTL_TELEMETRY
+
+namespace detail
+{
+
+void recordPoll(rtttl_context_t & c)
+{
+  rtttl_telemetry_t & t = c.telemetry;
+  unsigned long now = getTime();
+  if (t.polled)
+  {
+    unsigned long gap = now - t.lastPoll;
+    if (gap > t.maxPollGap)
+      t.maxPollGap = gap;
+  }
+  t.lastPoll = now;
+  t.polled = true;
+}
+
+void recordNoteStart(rtttl_context_t & c)
+{
+  rtttl_telemetry_t & t = c.telemetry;
+  if (t.notesPlayed > 0)
+  {
+    // the first note has no scheduled start
+    unsigned long now = getTime();
+    unsigned long scheduled = getNextNoteTime(c);
+    unsigned long lateness = (isTimeBefore(now, scheduled) ? 0 : now - scheduled);
+    if (lateness > t.maxLateness)
+      t.maxLateness = lateness;
+    t.totalLateness += lateness;
+  }
+  t.notesPlayed++;
+}
+
+unsigned long getParseTime()
+{
+  return (_micros != NULL ? _micros() : 0);
+}
+
+void recordParseTime(rtttl_context_t & c, unsigned long iParseStart)
+{
+  if (_micros == NULL)
+    return;
+
+  rtttl_telemetry_t & t = c.telemetry;
+  unsigned long elapsed = _micros() - iParseStart;
+  if (elapsed > t.maxParseUs)
+    t.maxParseUs = elapsed;
+  t.totalParseUs += elapsed;
+  t.notesParsed++;
+}
+
+}; //detail namespace
+
+namespace telemetry
+{
+
+bool isEnabled()
+{
+  return true;
+}
+
+void reset(rtttl_context_t & c)
+{
+  rtttl_telemetry_t & t = c.telemetry;
+  t.notesPlayed = 0;
+  t.maxLateness = 0;
+  t.totalLateness = 0;
+  t.maxPollGap = 0;
+  t.lastPoll = 0;
+  t.polled = false;
+  t.notesParsed = 0;
+  t.maxParseUs = 0;
+  t.totalParseUs = 0;
+}
+
+uint16_t getNotesPlayed(const rtttl_context_t & c)
+{
+  return c.telemetry.notesPlayed;
+}
+
+unsigned long getMaxLateness(const rtttl_context_t & c)
+{
+  return c.telemetry.maxLateness;
+}
+
+unsigned long getMeanLateness(const rtttl_context_t & c)
+{
+  const rtttl_telemetry_t & t = c.telemetry;
+  return (t.notesPlayed > 1 ? t.totalLateness / (t.notesPlayed - 1) : 0);
+}
+
+unsigned long getMaxPollGap(const rtttl_context_t & c)
+{
+  return c.telemetry.maxPollGap;
+}
+
+unsigned long getMaxParseTime(const rtttl_context_t & c)
+{
+  return c.telemetry.maxParseUs;
+}
+
+unsigned long getMeanParseTime(const rtttl_context_t & c)
+{
+  const rtttl_telemetry_t & t = c.telemetry;
+  return (t.notesParsed > 0 ? t.totalParseUs / t.notesParsed : 0);
+}
+
+}; //telemetry namespace
+
+#else
+
+namespace telemetry
+{
+
+bool isEnabled()                                      { return false; }
+void reset(rtttl_context_t &)                         {}
+uint16_t getNotesPlayed(const rtttl_context_t &)      { return 0; }
+unsigned long getMaxLateness(const rtttl_context_t &)     { return 0; }
+unsigned long getMeanLateness(const rtttl_context_t &)    { return 0; }
+unsigned long getMaxPollGap(const rtttl_context_t &)      { return 0; }
+unsigned long getMaxParseTime(const rtttl_context_t &)    { return 0; }
+unsigned long getMeanParseTime(const rtttl_context_t &)   { return 0; }
+
+}; //telemetry namespace
+
+#endif // ANY_RTTTL_TELEMETRY
+
+}; //anyrtttl namespace
@@ -0,0 +1,90 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_TELEMETRY_H
+#define RTTTL_TELEMETRY_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Telemetry API
+ *
+ * Playback statistics of a context, for sizing the time budget of loop().
+ * The statistics are only recorded when the global macro ANY_RTTTL_TELEMETRY
+ * is defined. See GlobalMacros.md. Otherwise, the context has no statistics,
+ * play() is unchanged and all functions return 0.
+ *
+ * Times are in milliseconds or in microseconds, like the clock of the
+ * timing mode (see setTimingMode()), except for parsing times which are
+ * always in microseconds. Statistics are reset when a melody begins.
+ ****************************************************************************/
+namespace telemetry
+{
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the library is compiled with ANY_RTTTL_TELEMETRY.
+ ****************************************************************************/
+bool isEnabled();
+
+/****************************************************************************
+ * Description:
+ *   Clears the statistics of the given context.
+ ****************************************************************************/
+void reset(rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of notes played.
+ ****************************************************************************/
+uint16_t getNotesPlayed(const rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Returns the maximum and the mean delay between the scheduled start of
+ *   a note and the call to play() that started it.
+ *   The first note of a melody has no scheduled start and is not included.
+ ****************************************************************************/
+unsigned long getMaxLateness(const rtttl_context_t & c);
+unsigned long getMeanLateness(const rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Returns the longest time between two calls to play() while the melody
+ *   is playing. Calls to play() while the melody is paused are ignored.
+ ****************************************************************************/
+unsigned long getMaxPollGap(const rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Returns the maximum and the mean time spent parsing or decoding a note
+ *   in play(), in microseconds. Precompiled and streamed melodies are not
+ *   parsed by play(). Requires a micros() function. See setMicrosFunction().
+ ****************************************************************************/
+unsigned long getMaxParseTime(const rtttl_context_t & c);
+unsigned long getMeanParseTime(const rtttl_context_t & c);
+
+/****************************************************************************
+ * Legacy API functions
+ ****************************************************************************/
+inline void reset()                             { reset(anyrtttl::gGlobalContext); }
+inline uint16_t getNotesPlayed()                { return getNotesPlayed(anyrtttl::gGlobalContext); }
+inline unsigned long getMaxLateness()           { return getMaxLateness(anyrtttl::gGlobalContext); }
+inline unsigned long getMeanLateness()          { return getMeanLateness(anyrtttl::gGlobalContext); }
+inline unsigned long getMaxPollGap()            { return getMaxPollGap(anyrtttl::gGlobalContext); }
+inline unsigned long getMaxParseTime()          { return getMaxParseTime(anyrtttl::gGlobalContext); }
+inline unsigned long getMeanParseTime()         { return getMeanParseTime(anyrtttl::gGlobalContext); }
+
+}; //telemetry namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_TELEMETRY_H
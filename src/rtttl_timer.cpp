@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_timer.h"
+
+namespace anyrtttl
+{
+
+namespace timer
+{
+
+static TimerStartFuncPtr gTimerStart = NULL;
+static TimerStopFuncPtr gTimerStop = NULL;
+static unsigned long gTimerPeriodUs = ANY_RTTTL_TIMER_PERIOD_US;
+
+// The context played by the timer. Shared with the timer callback.
+static rtttl_context_t * volatile gTimerContext = NULL;
+
+void setTimerFunctions(TimerStartFuncPtr iStartFunc, TimerStopFuncPtr iStopFunc)
+{
+  gTimerStart = iStartFunc;
+  gTimerStop = iStopFunc;
+}
+
+void setPeriod(unsigned long iPeriodUs)
+{
+  gTimerPeriodUs = iPeriodUs;
+}
+
+unsigned long getPeriod()
+{
+  return gTimerPeriodUs;
+}
+
+bool play(rtttl_context_t & c)
+{
+  // detach the previous melody from the timer
+  if (gTimerStop)
+    gTimerStop();
+  rtttl_context_t * previous = gTimerContext;
+  gTimerContext = NULL;
+
+  // stop the previous melody, unless it is replaced by itself
+  if (previous != NULL && previous != &c)
+    nonblocking::stop(*previous);
+
+  // play the first note now
+  nonblocking::play(c);
+  if (!c.playing)
+    return false;
+
+  gTimerContext = &c;
+  if (gTimerStart)
+    gTimerStart(gTimerPeriodUs, &tick);
+  return true;
+}
+
+void stop()
+{
+  // stop the timer before the melody. The callback must not use the context anymore.
+  if (gTimerStop)
+    gTimerStop();
+
+  rtttl_context_t * c = gTimerContext;
+  gTimerContext = NULL;
+  if (c)
+    nonblocking::stop(*c);
+}
+
+void tick()
+{
+  rtttl_context_t * c = gTimerContext;
+  if (c == NULL)
+    return;
+
+  nonblocking::play(*c);
+
+  if (!c->playing)
+  {
+    // end of the melody
+    gTimerContext = NULL;
+    if (gTimerStop)
+      gTimerStop();
+  }
+}
+
+bool isPlaying()
+{
+  rtttl_context_t * c = gTimerContext;
+  return (c != NULL && ((volatile bool &)c->playing));
+}
+
+}; //timer namespace
+
+}; //anyrtttl namespace
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_TIMER_H
+#define RTTTL_TIMER_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+#ifndef ANY_RTTTL_TIMER_PERIOD_US
+#define ANY_RTTTL_TIMER_PERIOD_US 1000 // default period of the playback timer in microseconds.
+#endif
+
+namespace anyrtttl
+{
+
+/****************************************************************************
+ * Timer source
+ *
+ * The timer engine does not depend on a specific hardware timer.
+ * A timer source is a pair of functions which starts and stops a periodic
+ * timer that calls the given callback function once per period.
+ * The stop function may be called from within the callback function.
+ ****************************************************************************/
+typedef void (*TimerCallbackFuncPtr)(void);
+typedef void (*TimerStartFuncPtr)(unsigned long iPeriodUs, TimerCallbackFuncPtr iCallback);
+typedef void (*TimerStopFuncPtr)(void);
+
+/****************************************************************************
+ * Timer API
+ *
+ * Plays a melody from a periodic timer callback (usually a timer interrupt)
+ * instead of calling nonblocking::play() from the loop() function.
+ * Note transitions are accurate to the timer period no matter how long
+ * the loop() function takes.
+ ****************************************************************************/
+namespace timer
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines the timer source used for playing melodies.
+ *   Without a timer source, tick() must be called periodically by the
+ *   sketch, for example from a custom interrupt service routine.
+ * Parameters:
+ *   iStartFunc: A function that starts a periodic timer.
+ *   iStopFunc:  A function that stops the periodic timer.
+ ****************************************************************************/
+void setTimerFunctions(TimerStartFuncPtr iStartFunc, TimerStopFuncPtr iStopFunc);
+
+/****************************************************************************
+ * Description:
+ *   Defines the period of the timer in microseconds.
+ *   The default period is ANY_RTTTL_TIMER_PERIOD_US.
+ *   The new period is used the next time the timer is started.
+ ****************************************************************************/
+void setPeriod(unsigned long iPeriodUs);
+unsigned long getPeriod();
+
+/****************************************************************************
+ * Description:
+ *   Plays a melody that was started with one of the nonblocking::begin
+ *   functions from the timer. The first note is played immediately.
+ *   The context must remain valid until the melody is done playing.
+ *   Stops the melody previously played by the timer, if any.
+ * Parameters:
+ *   c: An RTTTL context to keep track of the melody's state.
+ * Returns:
+ *   Returns true if the melody is playing and false otherwise.
+ ****************************************************************************/
+bool play(rtttl_context_t & c);
+
+/****************************************************************************
+ * Description:
+ *   Stops the timer and the melody played by the timer.
+ ****************************************************************************/
+void stop();
+
+/****************************************************************************
+ * Description:
+ *   Starts playing a melody from the timer.
+ *   Accepts the same arguments as nonblocking::begin().
+ *   For binary melodies, use nonblocking::beginBinary10() or
+ *   nonblocking::beginBinary16() followed by timer::play().
+ * Returns:
+ *   Returns true if the melody is playing and false otherwise.
+ ****************************************************************************/
+template<typename... Args>
+bool begin(rtttl_context_t & c, Args... args)
+{
+  stop();
+  nonblocking::begin(c, args...);
+  return play(c);
+}
+
+/****************************************************************************
+ * Description:
+ *   Plays the next note of the melody when required.
+ *   This function is the callback of the timer source. Call it periodically
+ *   from a custom interrupt service routine if no timer source is defined.
+ ****************************************************************************/
+void tick();
+
+/****************************************************************************
+ * Description:
+ *   Return true when the timer is playing a melody.
+ ****************************************************************************/
+bool isPlaying();
+
+/****************************************************************************
+ * Description:
+ *   Return true when the timer is done playing its melody.
+ ****************************************************************************/
+inline bool done() { return !isPlaying(); }
+
+}; //timer namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_TIMER_H
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "rtttl_trace.h"
+
+namespace anyrtttl
+{
+
+#ifdef ANY_RTTTL_TRACE
+
+static_assert((ANY_RTTTL_TRACE_SIZE & (ANY_RTTTL_TRACE_SIZE - 1)) == 0, "ANY_RTTTL_TRACE_SIZE must be a power of 2");
+
+static rtttl_trace_record_t gTraceRecords[ANY_RTTTL_TRACE_SIZE];
+static volatile uint32_t gTraceWriteCount = 0; // number of records written since the last clear().
+
+namespace detail
+{
+
+static void trace(const rtttl_context_t & c, byte iEvent, uint16_t iValue, unsigned long iTime)
+{
+  rtttl_trace_record_t & r = gTraceRecords[gTraceWriteCount & (ANY_RTTTL_TRACE_SIZE - 1)];
+  r.time = (uint32_t)iTime;
+  r.event = iEvent;
+  r.pin = c.pin;
+  r.value = iValue;
+  gTraceWriteCount++;
+}
+
+void trace(const rtttl_context_t & c, byte iEvent, uint16_t iValue)
+{
+  trace(c, iEvent, iValue, getTime());
+}
+
+void traceNoteEnd(const rtttl_context_t & c)
+{
+  if (c.noteIndex == 0)
+    return; // no note was played
+
+  unsigned long now = getTime();
+  unsigned long scheduled = getNextNoteTime(c);
+  unsigned long lateness = (isTimeBefore(now, scheduled) ? 0 : now - scheduled);
+  trace(c, RTTTL_TRACE_NOTE_END, c.noteIndex - 1, now);
+  if (lateness >= ANY_RTTTL_TRACE_LATE_THRESHOLD)
+    trace(c, RTTTL_TRACE_LATE_POLL, (lateness > 0xFFFF ? 0xFFFF : (uint16_t)lateness), now);
+}
+
+}; //detail namespace
+
+#endif // ANY_RTTTL_TRACE
+
+namespace trace
+{
+
+#ifdef ANY_RTTTL_TRACE
+
+bool isEnabled()
+{
+  return true;
+}
+
+void clear()
+{
+  gTraceWriteCount = 0;
+}
+
+uint16_t getCount()
+{
+  uint32_t count = gTraceWriteCount;
+  return (uint16_t)(count < ANY_RTTTL_TRACE_SIZE ? count : ANY_RTTTL_TRACE_SIZE);
+}
+
+uint32_t getOverwritten()
+{
+  uint32_t count = gTraceWriteCount;
+  return (count > ANY_RTTTL_TRACE_SIZE ? count - ANY_RTTTL_TRACE_SIZE : 0);
+}
+
+bool getRecord(uint16_t iIndex, rtttl_trace_record_t & oRecord)
+{
+  if (iIndex >= getCount())
+    return false;
+  uint32_t first = gTraceWriteCount - getCount();
+  oRecord = gTraceRecords[(first + iIndex) & (ANY_RTTTL_TRACE_SIZE - 1)];
+  return true;
+}
+
+#else
+
+bool isEnabled()                                                  { return false; }
+void clear()                                                      {}
+uint16_t getCount()                                               { return 0; }
+uint32_t getOverwritten()                                         { return 0; }
+bool getRecord(uint16_t, rtttl_trace_record_t &)                  { return false; }
+
+#endif // ANY_RTTTL_TRACE
+
+static unsigned char * writeUint16(unsigned char * p, uint16_t iValue)
+{
+  *p++ = (unsigned char)(iValue & 0xFF);
+  *p++ = (unsigned char)(iValue >> 8);
+  return p;
+}
+
+uint16_t dump(unsigned char * oBuffer, uint16_t iMaxSize)
+{
+  uint16_t count = getCount();
+  uint32_t size = RTTTL_TRACE_HEADER_SIZE + (uint32_t)count * RTTTL_TRACE_RECORD_SIZE;
+  if (size > 0xFFFF)
+    return 0;
+  if (oBuffer == NULL)
+    return (uint16_t)size;
+  if (size > iMaxSize)
+    return 0;
+
+  uint32_t overwritten = getOverwritten();
+  unsigned char * p = oBuffer;
+  *p++ = 'R';
+  *p++ = 'T';
+  *p++ = 1; // version
+  *p++ = gTimingMode;
+  p = writeUint16(p, count);
+  p = writeUint16(p, (uint16_t)(overwritten > 0xFFFF ? 0xFFFF : overwritten));
+
+  for(uint16_t i=0; i<count; i++)
+  {
+    rtttl_trace_record_t r;
+    getRecord(i, r);
+    p = writeUint16(p, (uint16_t)(r.time & 0xFFFF));
+    p = writeUint16(p, (uint16_t)(r.time >> 16));
+    *p++ = r.event;
+    *p++ = r.pin;
+    p = writeUint16(p, r.value);
+  }
+  return (uint16_t)size;
+}
+
+}; //trace namespace
+
+}; //anyrtttl namespace
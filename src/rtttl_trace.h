@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_TRACE_H
+#define RTTTL_TRACE_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+#ifndef ANY_RTTTL_TRACE_SIZE
+#define ANY_RTTTL_TRACE_SIZE 64 // number of records of the trace buffer. Must be a power of 2.
+#endif
+
+#ifndef ANY_RTTTL_TRACE_LATE_THRESHOLD
+#define ANY_RTTTL_TRACE_LATE_THRESHOLD 1 // minimum delay of a RTTTL_TRACE_LATE_POLL event, in the unit of the timing mode.
+#endif
+
+namespace anyrtttl
+{
+
+static constexpr byte RTTTL_TRACE_RECORD_SIZE = 8;  // size of a record in a dump, in bytes.
+static constexpr byte RTTTL_TRACE_HEADER_SIZE = 8;  // size of the header of a dump, in bytes.
+
+/****************************************************************************
+ * Description:
+ *   Defines a record of the trace buffer.
+ ****************************************************************************/
+typedef struct rtttl_trace_record_t {
+  uint32_t time;              // time of the event with the clock of the timing mode. See setTimingMode().
+  byte event;                 // the event. See rtttl_trace_event_t.
+  byte pin;                   // the pin of the context.
+  uint16_t value;             // a value that depends on the event. See rtttl_trace_event_t.
+} rtttl_trace_record_t;
+
+/****************************************************************************
+ * Trace API
+ *
+ * A binary trace of the player's events, for debugging timing problems.
+ * The events are only recorded when the global macro ANY_RTTTL_TRACE is
+ * defined. See GlobalMacros.md. Each event is a small fixed size record
+ * written to a ring buffer in RAM. The oldest records are overwritten when
+ * the buffer is full. Recording an event never prints to the serial port.
+ * When ANY_RTTTL_TRACE is not defined, the player is unchanged and the
+ * buffer is always empty.
+ *
+ * Format of a dump. All values are little endian:
+ *   2 bytes  magic 'R', 'T'
+ *   1 byte   version (1)
+ *   1 byte   timing mode. See rtttl_timing_t.
+ *   2 bytes  number of records
+ *   2 bytes  number of overwritten records, up to 0xFFFF
+ *   8 bytes  per record, oldest first: time (4 bytes), event, pin, value (2 bytes)
+ * Use the anyrtttl_trace tool to convert a dump to a readable timeline.
+ ****************************************************************************/
+namespace trace
+{
+
+/****************************************************************************
+ * Description:
+ *   Returns true if the library is compiled with ANY_RTTTL_TRACE.
+ ****************************************************************************/
+bool isEnabled();
+
+/****************************************************************************
+ * Description:
+ *   Removes all records from the trace buffer.
+ ****************************************************************************/
+void clear();
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of records in the trace buffer.
+ ****************************************************************************/
+uint16_t getCount();
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of records that were overwritten since the last clear().
+ ****************************************************************************/
+uint32_t getOverwritten();
+
+/****************************************************************************
+ * Description:
+ *   Reads a record of the trace buffer.
+ * Parameters:
+ *   iIndex:  The index of the record. 0 is the oldest record.
+ *   oRecord: The output record.
+ * Returns:
+ *   Returns true if the record exists.
+ ****************************************************************************/
+bool getRecord(uint16_t iIndex, rtttl_trace_record_t & oRecord);
+
+/****************************************************************************
+ * Description:
+ *   Writes the trace buffer to a binary dump. See the format above.
+ *   Records that are added while dumping may be lost. Dump the buffer
+ *   when no melody is played from an interrupt.
+ * Parameters:
+ *   oBuffer:   The output buffer. Can be NULL to only compute the required size.
+ *   iMaxSize:  The size of oBuffer in bytes.
+ * Returns:
+ *   Returns the size of the dump in bytes. Returns 0 if oBuffer is too small.
+ ****************************************************************************/
+uint16_t dump(unsigned char * oBuffer, uint16_t iMaxSize);
+
+}; //trace namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_TRACE_H
@@ -84,15 +84,56 @@ static constexpr uint16_t gNoteOctavesCount = sizeof(gNoteOctaves)/sizeof(gNoteO
 static constexpr bpm_value_t gNoteBpms[] = {25, 28, 31, 35, 40, 45, 50, 56, 63, 70, 80, 90, 100, 112, 125, 140, 160, 180, 200, 225, 250, 285, 320, 355, 400, 450, 500, 565, 635, 715, 800, 900};
 static constexpr uint16_t gNoteBpmsCount = sizeof(gNoteBpms)/sizeof(gNoteBpms[0]);
 
+/****************************************************************************
+ * Character classes
+ *
+ * Each ASCII character is mapped to a character info byte in the
+ * gCharacterInfos table. The high nibble is the class of the character
+ * (see character_class_t) and the low nibble is its value:
+ *   RTTTL_CHAR_DIGIT, RTTTL_CHAR_OCTAVE: the value of the digit.
+ *   RTTTL_CHAR_NOTE:                    the note index in gNoteValues.
+ * Uppercase note letters have the same info as lowercase note letters.
+ ****************************************************************************/
+enum character_class_t {
+  RTTTL_CHAR_OTHER = 0,   // any character without a meaning in RTTTL.
+  RTTTL_CHAR_END,         // '\0'
+  RTTTL_CHAR_SPACE,       // ' ', '\t', '\r' or '\n'
+  RTTTL_CHAR_DIGIT,       // '0' to '9', except octave digits.
+  RTTTL_CHAR_OCTAVE,      // '4' to '7'
+  RTTTL_CHAR_NOTE,        // a note letter. See gNoteValues.
+  RTTTL_CHAR_SHARP,       // '#'
+  RTTTL_CHAR_DOT,         // '.'
+  RTTTL_CHAR_SEPARATOR,   // ','
+  RTTTL_CHAR_SECTION,     // ':'
+  RTTTL_CHAR_EQUAL,       // '='
+};
+
+static constexpr byte gCharacterInfosCount = 128;
+extern const byte gCharacterInfos[gCharacterInfosCount] PROGMEM;
+
+inline __attribute__((always_inline)) byte getCharacterInfo(char c)
+{
+  if ((unsigned char)c < gCharacterInfosCount)
+    return pgm_read_byte(&gCharacterInfos[(unsigned char)c]);
+  return RTTTL_CHAR_OTHER;
+}
+
+inline __attribute__((always_inline)) byte getCharacterClass(byte iInfo)
+{
+  return (iInfo >> 4);
+}
+
+inline __attribute__((always_inline)) byte getCharacterValue(byte iInfo)
+{
+  return (iInfo & 0x0F);
+}
+
+inline bpm_index_t findBpmIndexFromValue(bpm_value_t n);
+
 inline bool isValidBpm(bpm_value_t value)
 {
   #ifdef RTTTL_PARSER_STRICT
-    for(bpm_index_t i=0; i<gNoteBpmsCount; i++)
-    {
-      if (gNoteBpms[i] == value)
-        return true;
-    }
-    return false;
+    return (findBpmIndexFromValue(value) != INVALID_BPM_INDEX);
   #else
     if (value >= RTTTL_BMP_MIN_VALUE && value <= RTTTL_BMP_MAX_VALUE)
       return true;
@@ -109,9 +150,7 @@ inline bool isValidDuration(duration_value_t value)
 
 inline bool isValidNoteValue(char c)
 {
-  if ((c >= 'a' && c <= 'g') || c == 'p')
-    return true;
-  return false;
+  return (getCharacterClass(getCharacterInfo(c)) == RTTTL_CHAR_NOTE);
 }
 
 inline bool isValidOctave(octave_value_t value)
@@ -123,8 +162,7 @@ inline bool isValidOctave(octave_value_t value)
 
 inline bool isValidOctave(char c)
 {
-  octave_value_t value = (octave_value_t)(c - '0'); // convert from ascii to integer
-  return isValidOctave(value);
+  return (getCharacterClass(getCharacterInfo(c)) == RTTTL_CHAR_OCTAVE);
 }
 
 inline note_value_t getNoteValueFromIndex(note_index_t iIndex)
@@ -136,13 +174,9 @@ inline note_value_t getNoteValueFromIndex(note_index_t iIndex)
 
 inline note_index_t findNoteIndexFromNoteValue(note_value_t n)
 {
-  for(note_index_t i=0; i<gNoteValuesCount; i++)
-  {
-    if (getNoteValueFromIndex(i) == n)
-    {
-      return i;
-    }
-  }
+  byte info = getCharacterInfo(n);
+  if (getCharacterClass(info) == RTTTL_CHAR_NOTE)
+    return getCharacterValue(info);
   return INVALID_NOTE_LETTER_INDEX;
 }
 
@@ -168,14 +202,10 @@ inline duration_value_t getDurationValueFromIndex(duration_index_t iIndex)
 
 inline duration_index_t findDurationIndexFromValue(duration_value_t n)
 {
-  for(duration_index_t i=0; i<gNoteDurationsCount; i++)
-  {
-    if (getDurationValueFromIndex(i) == n)
-    {
-      return i;
-    }
-  }
-  return INVALID_DURATION_INDEX;
+  // Durations are powers of 2. The index of a duration is the position of its single bit.
+  if (n == 0 || n > gNoteDurations[gNoteDurationsCount-1] || (n & (n-1)) != 0)
+    return INVALID_DURATION_INDEX;
+  return (duration_index_t)(((n & 0xAA) != 0) | (((n & 0xCC) != 0) << 1) | (((n & 0xF0) != 0) << 2));
 }
 
 inline octave_value_t getOctaveValueFromIndex(octave_index_t iIndex)
@@ -187,13 +217,8 @@ inline octave_value_t getOctaveValueFromIndex(octave_index_t iIndex)
 
 inline octave_index_t findOctaveIndexFromValue(octave_value_t n)
 {
-  for(octave_index_t i=0; i<gNoteOctavesCount; i++)
-  {
-    if (getOctaveValueFromIndex(i) == n)
-    {
-      return i;
-    }
-  }
+  if (isValidOctave(n))
+    return (octave_index_t)(n - gNoteOctaves[0]);
   return INVALID_OCTAVE_INDEX;
 }
 
@@ -206,13 +231,19 @@ inline bpm_value_t getBpmValueFromIndex(bpm_index_t iIndex)
 
 inline bpm_index_t findBpmIndexFromValue(bpm_value_t n)
 {
-  for(bpm_index_t i=0; i<gNoteBpmsCount; i++)
+  // binary search in the sorted gNoteBpms array
+  bpm_index_t first = 0;
+  bpm_index_t last = gNoteBpmsCount;
+  while (first < last)
   {
-    if (getBpmValueFromIndex(i) == n)
-    {
-      return i;
-    }
+    bpm_index_t middle = (first + last) / 2;
+    if (gNoteBpms[middle] < n)
+      first = middle + 1;
+    else
+      last = middle;
   }
+  if (first < gNoteBpmsCount && gNoteBpms[first] == n)
+    return first;
   return INVALID_BPM_INDEX;
 }
 
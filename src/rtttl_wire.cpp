@@ -0,0 +1,408 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+#include "binrtttl.h"
+#include "rtttl_wire.h"
+
+namespace anyrtttl
+{
+
+namespace wire
+{
+
+// Parts of a frame. The state is the part of the frame being received.
+enum wire_state_t {
+  WIRE_STATE_SYNC = 0,    // waiting for the sync byte.
+  WIRE_STATE_TYPE,
+  WIRE_STATE_SEQUENCE,
+  WIRE_STATE_LENGTH,
+  WIRE_STATE_PAYLOAD,
+  WIRE_STATE_CRC_LOW,
+  WIRE_STATE_CRC_HIGH,
+  WIRE_STATE_NOTES,       // adding the notes of a NOTES frame to the stream.
+};
+
+static const byte START_PAYLOAD_SIZE = 1 + sizeof(RTTTL_CONTROL_SECTION);
+static const uint16_t CRC_INITIAL_VALUE = 0xFFFF;
+
+uint16_t updateCrc(uint16_t iCrc, byte iValue)
+{
+  iCrc ^= (uint16_t)iValue << 8;
+  for(byte i=0; i<8; i++)
+    iCrc = (iCrc & 0x8000 ? (iCrc << 1) ^ 0x1021 : (iCrc << 1));
+  return iCrc;
+}
+
+static bool isValidBitsPerNote(byte iBitsPerNote)
+{
+  return (iBitsPerNote == RTTTL_NOTE_SIZE_BITS || iBitsPerNote == 8*sizeof(RTTTL_NOTE));
+}
+
+/****************************************************************************
+ * Description:
+ *   Reads the control section of a START frame into the stream.
+ ****************************************************************************/
+static bool readStartFrame(rtttl_wire_t & w)
+{
+  if (w.length != START_PAYLOAD_SIZE || !isValidBitsPerNote(w.payload[0]))
+    return false;
+
+  RTTTL_CONTROL_SECTION ctrl;
+  ctrl.raw = w.payload[1] | (w.payload[2] << 8);
+  if (ctrl.bpm == 0)
+    return false;
+
+  rtttl_stream_t & s = *w.stream;
+  duration_value_t d = getDurationValueFromIndex(ctrl.durationIdx);
+  if (isValidDuration(d))
+    s.melodyDefaultDur = d;
+  s.melodyDefaultOct = getOctaveValueFromIndex(ctrl.octaveIdx);
+  s.bpm = ctrl.bpm;
+
+  // BPM usually expresses the number of quarter notes per minute
+  s.wholeNote = (60 * 1000L / s.bpm) * 4;  // this is the time for whole note (in milliseconds)
+
+  w.bitsPerNote = w.payload[0];
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Adds the notes of the last NOTES frame to the stream.
+ * Returns:
+ *   Returns true when all notes are added and false if the queue is full.
+ ****************************************************************************/
+static bool pushNotes(rtttl_wire_t & w)
+{
+  rtttl_stream_t & s = *w.stream;
+
+  // decode the notes with the binary player's decoder
+  rtttl_context_t c;
+  initContext(c);
+  c.format = (w.bitsPerNote == RTTTL_NOTE_SIZE_BITS ? RTTTL_FORMAT_BINARY10 : RTTTL_FORMAT_BINARY16);
+  c.buffer = (const char *)w.payload;
+  c.getCharPtr = &readCharMem;
+  c.melodyDefaultDur = s.melodyDefaultDur;
+  c.wholeNote = s.wholeNote;
+
+  while (w.noteIndex < w.notesCount)
+  {
+    c.noteIndex = w.noteIndex;
+    detail::decodeBinaryNote(c);
+
+    rtttl_stream_note_t n;
+    n.duration = c.duration;
+    n.scale = c.scale;
+    n.noteOffset = c.noteOffset;
+    n.noteDivisor = c.noteDivisor;
+    n.noteDots = c.noteDots;
+    if (!detail::pushStreamNote(s, n))
+      return false; // wait until a note is played
+    w.noteIndex++;
+  }
+
+  w.state = WIRE_STATE_SYNC;
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Processes a frame with a valid CRC.
+ ****************************************************************************/
+static void readFrame(rtttl_wire_t & w)
+{
+  w.state = WIRE_STATE_SYNC;
+  if (_millis != NULL)
+    w.lastActivityTime = _millis();
+
+  if (w.type == RTTTL_WIRE_FRAME_START)
+  {
+    if (!readStartFrame(w))
+    {
+      w.errors++;
+      return;
+    }
+    w.nextSequence = w.sequence + 1;
+    return;
+  }
+
+  if (w.bitsPerNote == 0)
+  {
+    w.errors++; // the START frame was lost
+    return;
+  }
+  if (w.sequence != w.nextSequence)
+    w.errors++; // frames were lost. Play the rest of the melody.
+  w.nextSequence = w.sequence + 1;
+
+  if (w.type == RTTTL_WIRE_FRAME_NOTES)
+  {
+    w.notesCount = (byte)(((uint16_t)w.length * 8) / w.bitsPerNote);
+    w.noteIndex = 0;
+    w.state = WIRE_STATE_NOTES;
+    pushNotes(w);
+  }
+  else if (w.type == RTTTL_WIRE_FRAME_END)
+    detail::endStream(*w.stream);
+  else
+    w.errors++; // unknown frame
+}
+
+/****************************************************************************
+ * Description:
+ *   Reads a byte of a frame.
+ * Returns:
+ *   Returns false if the frame is rejected. The state is left unchanged
+ *   for rescanning the bytes of the frame. See rescan().
+ ****************************************************************************/
+static bool readByte(rtttl_wire_t & w, byte iValue)
+{
+  switch(w.state)
+  {
+    case WIRE_STATE_SYNC:
+      if (iValue == RTTTL_WIRE_SYNC)
+      {
+        w.crc = CRC_INITIAL_VALUE;
+        w.state = WIRE_STATE_TYPE;
+      }
+      break;
+    case WIRE_STATE_TYPE:
+      w.type = iValue;
+      w.crc = updateCrc(w.crc, iValue);
+      w.state = WIRE_STATE_SEQUENCE;
+      break;
+    case WIRE_STATE_SEQUENCE:
+      w.sequence = iValue;
+      w.crc = updateCrc(w.crc, iValue);
+      w.state = WIRE_STATE_LENGTH;
+      break;
+    case WIRE_STATE_LENGTH:
+      if (iValue > RTTTL_WIRE_MAX_PAYLOAD)
+        return false; // not a frame
+      w.length = iValue;
+      w.position = 0;
+      w.crc = updateCrc(w.crc, iValue);
+      w.state = (w.length > 0 ? WIRE_STATE_PAYLOAD : WIRE_STATE_CRC_LOW);
+      break;
+    case WIRE_STATE_PAYLOAD:
+      w.payload[w.position++] = iValue;
+      w.crc = updateCrc(w.crc, iValue);
+      if (w.position == w.length)
+        w.state = WIRE_STATE_CRC_LOW;
+      break;
+    case WIRE_STATE_CRC_LOW:
+      w.crcLow = iValue;
+      w.state = WIRE_STATE_CRC_HIGH;
+      break;
+    case WIRE_STATE_CRC_HIGH:
+      if (w.crc != (((uint16_t)iValue << 8) | w.crcLow))
+        return false; // corrupted frame
+      readFrame(w);
+      break;
+    default:
+      break;
+  };
+  return true;
+}
+
+/****************************************************************************
+ * Description:
+ *   Drops a rejected frame and scans its bytes again for the sync byte of
+ *   a following frame. A corrupted length or a corrupted frame would
+ *   otherwise hide the frames that were received in its bytes.
+ * Parameters:
+ *   w:           The decoder. The state is the state of the rejected frame.
+ *   iLastValue:  The byte that rejected the frame.
+ ****************************************************************************/
+static void rescan(rtttl_wire_t & w, byte iLastValue)
+{
+  w.errors++;
+
+  // the bytes received after the sync byte of the rejected frame
+  unsigned char buffer[RTTTL_WIRE_FRAME_OVERHEAD - 1 + RTTTL_WIRE_MAX_PAYLOAD];
+  byte size = 0;
+  buffer[size++] = w.type;
+  buffer[size++] = w.sequence;
+  if (w.state == WIRE_STATE_CRC_HIGH)
+  {
+    buffer[size++] = w.length;
+    for(byte i=0; i<w.length; i++)
+      buffer[size++] = w.payload[i];
+    buffer[size++] = w.crcLow;
+  }
+  buffer[size++] = iLastValue;
+
+  w.state = WIRE_STATE_SYNC;
+  byte first = 0; // index of the first byte of the frame being scanned
+  for(byte i=0; i<size; i++)
+  {
+    if (w.state == WIRE_STATE_SYNC)
+      first = i+1;
+    if (!readByte(w, buffer[i]))
+    {
+      // not a frame either. Scan again from its first byte.
+      w.state = WIRE_STATE_SYNC;
+      i = first-1;
+      continue;
+    }
+    if (w.state == WIRE_STATE_NOTES)
+    {
+      if (i+1 < size)
+        w.errors++; // the queue is full. The rest of the bytes are dropped.
+      return;
+    }
+  }
+}
+
+void init(rtttl_wire_t & w, rtttl_stream_t & s)
+{
+  stream::init(s);
+  w.stream = &s;
+  w.state = WIRE_STATE_SYNC;
+  w.type = 0;
+  w.sequence = 0;
+  w.nextSequence = 0;
+  w.length = 0;
+  w.position = 0;
+  w.crc = CRC_INITIAL_VALUE;
+  w.crcLow = 0;
+  w.bitsPerNote = 0;
+  w.notesCount = 0;
+  w.noteIndex = 0;
+  w.errors = 0;
+  w.lastActivityTime = 0;
+}
+
+uint16_t feed(rtttl_wire_t & w, const unsigned char * iBuffer, uint16_t iSize)
+{
+  if (w.state == WIRE_STATE_NOTES && !pushNotes(w))
+    return 0;
+
+  // End a melody whose END frame was lost.
+  // The timeout only runs while the player waits for notes.
+  if (w.bitsPerNote != 0 && !stream::isEnded(*w.stream) && _millis != NULL)
+  {
+    unsigned long now = _millis();
+    if (stream::available(*w.stream) > 0)
+      w.lastActivityTime = now;
+    else if (now - w.lastActivityTime >= ANY_RTTTL_WIRE_TIMEOUT)
+    {
+      w.errors++;
+      detail::endStream(*w.stream);
+    }
+  }
+
+  for(uint16_t i=0; i<iSize; i++)
+  {
+    if (!readByte(w, iBuffer[i]))
+      rescan(w, iBuffer[i]);
+    if (w.state == WIRE_STATE_NOTES)
+      return i+1; // the queue is full. The rest of the notes are added by the next call.
+  }
+
+  return iSize;
+}
+
+static uint16_t readBits(const char * iBuffer, GetCharFuncPtr iGetCharFuncPtr, uint32_t iBitOffset, byte iBitCount)
+{
+  // Bits are read from the least significant bit to the most significant bit.
+  uint16_t value = 0;
+  for(byte i=0; i<iBitCount; i++)
+  {
+    uint32_t bit = iBitOffset + i;
+    byte b = (byte)iGetCharFuncPtr(iBuffer + (bit >> 3));
+    if (b & (1 << (bit & 0x07)))
+      value |= (1U << i);
+  }
+  return value;
+}
+
+static void writeBits(unsigned char * oBuffer, uint16_t iBitOffset, uint16_t iValue, byte iBitCount)
+{
+  // Bits are written from the least significant bit to the most significant bit.
+  for(byte i=0; i<iBitCount; i++)
+  {
+    uint16_t bit = iBitOffset + i;
+    unsigned char & b = oBuffer[bit >> 3];
+    if ((bit & 0x07) == 0)
+      b = 0; // first write to this byte. Padding bits are left cleared.
+    if (iValue & (1U << i))
+      b |= (unsigned char)(1 << (bit & 0x07));
+  }
+}
+
+/****************************************************************************
+ * Description:
+ *   Writes a frame to oBuffer at the given offset, if it fits.
+ * Returns:
+ *   Returns the offset following the frame.
+ ****************************************************************************/
+static uint32_t writeFrame(unsigned char * oBuffer, uint16_t iMaxSize, uint32_t iOffset, byte iType, byte iSequence, const unsigned char * iPayload, byte iLength)
+{
+  uint32_t end = iOffset + RTTTL_WIRE_FRAME_OVERHEAD + iLength;
+  if (oBuffer == NULL || end > iMaxSize)
+    return end;
+
+  unsigned char * p = oBuffer + iOffset;
+  *p++ = RTTTL_WIRE_SYNC;
+  *p++ = iType;
+  *p++ = iSequence;
+  *p++ = iLength;
+  for(byte i=0; i<iLength; i++)
+    *p++ = iPayload[i];
+
+  uint16_t crc = CRC_INITIAL_VALUE;
+  for(byte i=1; i<4+iLength; i++)
+    crc = updateCrc(crc, oBuffer[iOffset + i]);
+  *p++ = (unsigned char)(crc & 0xFF);
+  *p++ = (unsigned char)(crc >> 8);
+  return end;
+}
+
+uint16_t encode(const unsigned char * iBuffer, uint16_t iSize, byte iBitsPerNote, GetCharFuncPtr iGetCharFuncPtr, unsigned char * oBuffer, uint16_t iMaxSize)
+{
+  if (iBuffer == NULL || iGetCharFuncPtr == NULL || iSize < sizeof(RTTTL_CONTROL_SECTION) || !isValidBitsPerNote(iBitsPerNote))
+    return 0;
+
+  // the START frame
+  const char * p = (const char *)iBuffer;
+  unsigned char payload[RTTTL_WIRE_MAX_PAYLOAD];
+  payload[0] = iBitsPerNote;
+  payload[1] = (unsigned char)iGetCharFuncPtr(p);
+  payload[2] = (unsigned char)iGetCharFuncPtr(p+1);
+  byte sequence = 0;
+  uint32_t size = writeFrame(oBuffer, iMaxSize, 0, RTTTL_WIRE_FRAME_START, sequence++, payload, START_PAYLOAD_SIZE);
+
+  // the NOTES frames
+  const char * notes = p + sizeof(RTTTL_CONTROL_SECTION);
+  uint16_t notesCount = (uint16_t)(((uint32_t)(iSize - sizeof(RTTTL_CONTROL_SECTION)) * 8) / iBitsPerNote);
+  const byte notesPerFrame = (RTTTL_WIRE_MAX_PAYLOAD * 8) / iBitsPerNote;
+  for(uint16_t first=0; first<notesCount; first+=notesPerFrame)
+  {
+    byte count = (notesCount - first < notesPerFrame ? (byte)(notesCount - first) : notesPerFrame);
+    for(byte i=0; i<count; i++)
+    {
+      uint16_t raw = readBits(notes, iGetCharFuncPtr, (uint32_t)(first + i) * iBitsPerNote, iBitsPerNote);
+      writeBits(payload, (uint16_t)i * iBitsPerNote, raw, iBitsPerNote);
+    }
+    byte length = (byte)(((uint16_t)count * iBitsPerNote + 7) / 8);
+    size = writeFrame(oBuffer, iMaxSize, size, RTTTL_WIRE_FRAME_NOTES, sequence++, payload, length);
+  }
+
+  // the END frame
+  size = writeFrame(oBuffer, iMaxSize, size, RTTTL_WIRE_FRAME_END, sequence++, NULL, 0);
+
+  if (size > 0xFFFF || (oBuffer != NULL && size > iMaxSize))
+    return 0;
+  return (uint16_t)size;
+}
+
+}; //wire namespace
+
+}; //anyrtttl namespace
@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_WIRE_H
+#define RTTTL_WIRE_H
+
+#include "Arduino.h"
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+
+static constexpr byte RTTTL_WIRE_SYNC = 0xA5;           // first byte of a frame.
+static constexpr byte RTTTL_WIRE_MAX_PAYLOAD = 40;      // maximum size of the payload of a frame. 32 notes of 10 bits or 20 notes of 16 bits.
+static constexpr byte RTTTL_WIRE_FRAME_OVERHEAD = 6;    // size of a frame without its payload.
+
+#ifndef ANY_RTTTL_WIRE_TIMEOUT
+#define ANY_RTTTL_WIRE_TIMEOUT 1000 // time in milliseconds without frames and without queued notes after which a melody ends. The END frame was lost.
+#endif
+
+/****************************************************************************
+ * Description:
+ *   Defines the types of frames of the wire protocol.
+ ****************************************************************************/
+enum rtttl_wire_frame_t {
+  RTTTL_WIRE_FRAME_START = 1, // start of a melody. The payload is the number of bits per note (10 or 16) and the 2 bytes binary control section.
+  RTTTL_WIRE_FRAME_NOTES = 2, // binary notes packed with the number of bits per note of the melody, starting at bit 0.
+  RTTTL_WIRE_FRAME_END = 3,   // end of the melody. No payload.
+};
+
+/****************************************************************************
+ * Description:
+ *   Defines the state of a decoder of the wire protocol.
+ *   See the wire namespace.
+ ****************************************************************************/
+typedef struct rtttl_wire_t {
+  rtttl_stream_t * stream;    // the stream that receives the decoded notes.
+  byte state;                 // part of the frame being received. See wire_state_t.
+  byte type;                  // type of the frame being received. See rtttl_wire_frame_t.
+  byte sequence;              // sequence number of the frame being received.
+  byte nextSequence;          // expected sequence number of the next frame.
+  byte length;                // size of the payload of the frame being received.
+  byte position;              // number of bytes of the payload received.
+  uint16_t crc;               // CRC of the frame being received.
+  byte crcLow;                // low byte of the CRC received with the frame.
+  byte bitsPerNote;           // number of bits per note of the melody. 0 before the START frame.
+  byte notesCount;            // number of notes in the payload of the last NOTES frame.
+  byte noteIndex;             // index of the next note of the payload to add to the stream.
+  uint16_t errors;            // number of frames that were rejected or lost.
+  unsigned long lastActivityTime; // last time in milliseconds a frame was received or the queue of the stream had notes.
+  unsigned char payload[RTTTL_WIRE_MAX_PAYLOAD]; // payload of the frame being received.
+} rtttl_wire_t;
+
+/****************************************************************************
+ * Wire API
+ *
+ * A framed binary protocol for streaming melodies over a serial link.
+ * Each note is sent with the 10 or 16 bits RTTTL_NOTE encoding of binrtttl.h
+ * instead of about 3.3 characters per note for RTTTL text.
+ *
+ * Format of a frame:
+ *   1 byte   sync byte RTTTL_WIRE_SYNC (0xA5)
+ *   1 byte   type of the frame. See rtttl_wire_frame_t.
+ *   1 byte   sequence number, incremented for each frame of a melody.
+ *   1 byte   size of the payload (0 to RTTTL_WIRE_MAX_PAYLOAD).
+ *   N bytes  payload
+ *   2 bytes  CRC-16/CCITT-FALSE of the type, sequence, size and payload, little endian.
+ *
+ * A melody is a START frame, NOTES frames and an END frame.
+ * The decoder adds the notes to an rtttl_stream_t which is played with
+ * nonblocking::beginStream(). Only one frame is buffered: the melody
+ * starts playing with the first NOTES frame.
+ * A frame with an invalid CRC is dropped and its bytes are scanned again
+ * for the sync byte of a following frame. Dropped or lost frames are
+ * counted in errors and the rest of the melody is played.
+ * If the queue of the stream stays empty and no frame is received for
+ * ANY_RTTTL_WIRE_TIMEOUT milliseconds, the END frame is considered lost
+ * and the melody ends.
+ ****************************************************************************/
+namespace wire
+{
+
+/****************************************************************************
+ * Description:
+ *   Updates a CRC-16/CCITT-FALSE with a byte. The initial value is 0xFFFF.
+ ****************************************************************************/
+uint16_t updateCrc(uint16_t iCrc, byte iValue);
+
+/****************************************************************************
+ * Description:
+ *   Initializes a decoder ready to receive a new melody.
+ * Parameters:
+ *   w:       The decoder to initialize.
+ *   s:       The stream that receives the decoded notes. Initialized by this function.
+ ****************************************************************************/
+void init(rtttl_wire_t & w, rtttl_stream_t & s);
+
+/****************************************************************************
+ * Description:
+ *   Feeds bytes received from the link to the decoder.
+ *   Stops when the queue of the stream is full. The bytes that were not
+ *   consumed must be fed again once notes are played.
+ *   Must be called regularly, even without received bytes, for ending
+ *   a melody whose END frame was lost.
+ * Parameters:
+ *   w:       The decoder.
+ *   iBuffer: The received bytes.
+ *   iSize:   The number of bytes in iBuffer. Can be 0 to only add the
+ *            pending notes of the last frame to the stream.
+ * Returns:
+ *   Returns the number of bytes consumed by the decoder.
+ ****************************************************************************/
+uint16_t feed(rtttl_wire_t & w, const unsigned char * iBuffer, uint16_t iSize);
+
+/****************************************************************************
+ * Description:
+ *   Encodes a binary RTTTL melody as frames of the wire protocol.
+ * Parameters:
+ *   iBuffer:         The binary RTTTL melody, starting with the control section. See anyrtttl::encode().
+ *   iSize:           The size of iBuffer in bytes.
+ *   iBitsPerNote:    The number of bits per note of iBuffer. Must be 10 or 16.
+ *   iGetCharFuncPtr: A function pointer to read 1 byte from the given buffer.
+ *   oBuffer:         The output frames. Can be NULL to only compute the required size.
+ *   iMaxSize:        The size of oBuffer in bytes.
+ * Returns:
+ *   Returns the size in bytes of the frames.
+ *   Returns 0 if the melody is invalid or if oBuffer is too small.
+ ****************************************************************************/
+uint16_t encode(const unsigned char * iBuffer, uint16_t iSize, byte iBitsPerNote, GetCharFuncPtr iGetCharFuncPtr, unsigned char * oBuffer, uint16_t iMaxSize);
+
+// helper functions
+inline bool feed(rtttl_wire_t & w, unsigned char iValue)   { return (feed(w, &iValue, 1) == 1); }
+inline uint16_t encode(const unsigned char * iBuffer, uint16_t iSize, byte iBitsPerNote, unsigned char * oBuffer, uint16_t iMaxSize)    { return encode(iBuffer, iSize, iBitsPerNote, &anyrtttl::readCharMem, oBuffer, iMaxSize); }
+inline uint16_t encode_P(const unsigned char * iBuffer, uint16_t iSize, byte iBitsPerNote, unsigned char * oBuffer, uint16_t iMaxSize)  { return encode(iBuffer, iSize, iBitsPerNote, &anyrtttl::readCharPgm, oBuffer, iMaxSize); }
+
+}; //wire namespace
+
+}; //anyrtttl namespace
+
+#endif //RTTTL_WIRE_H
@@ -0,0 +1,316 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_catalog: Builds a catalog of RTTTL melodies.
+// The output is C source code ready to be included in an Arduino sketch.
+// See rtttl_catalog.h for the format of a catalog.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "anyrtttl.h"
+#include "binrtttl.h"
+#include "rtttl_catalog.h"
+
+struct catalog_item_t
+{
+  std::string name;
+  uint32_t hash;
+  std::vector<unsigned char> data;
+};
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [options] [--file <path>] [melody...]\n", iName);
+  printf("Builds a catalog of RTTTL melodies. See rtttl_catalog.h.\n");
+  printf("\n");
+  printf("  --format text|binary10|binary16  Format of the melodies in the catalog. Default is text.\n");
+  printf("  --name <identifier>              Name of the catalog array. Default is melodies_catalog.\n");
+  printf("  --output <file.h>                Output C source file. Default is the standard output.\n");
+  printf("  --bin <file>                     Also write the catalog as a raw binary file.\n");
+  printf("  --file <path>                    Read melodies from a text file, one melody per line.\n");
+  printf("                                   Lines that are not RTTTL melodies are ignored.\n");
+  printf("                                   Use '-' to read from standard input.\n");
+  printf("  melody                           An RTTTL melody. For example: \"tetris:d=4,o=5,b=160:e6,8b,8c6\"\n");
+}
+
+static std::string trim(const std::string & iValue)
+{
+  static const char * WHITESPACES = " \t\r\n";
+  size_t first = iValue.find_first_not_of(WHITESPACES);
+  if (first == std::string::npos)
+    return "";
+  size_t last = iValue.find_last_not_of(WHITESPACES);
+  return iValue.substr(first, last - first + 1);
+}
+
+// Returns a valid upper case C identifier from the name of a melody.
+static std::string getIdentifier(const std::string & iName)
+{
+  std::string identifier;
+  for(size_t i=0; i<iName.size(); i++)
+  {
+    char c = iName[i];
+    if (c >= 'a' && c <= 'z')
+      c -= ('a' - 'A');
+    if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')
+      identifier += c;
+    else if (!identifier.empty() && identifier[identifier.size()-1] != '_')
+      identifier += '_';
+  }
+  return identifier;
+}
+
+static bool isMelody(const std::string & iMelody)
+{
+  bool has_sections = (iMelody.find(':') != std::string::npos && iMelody.find(':') != iMelody.rfind(':'));
+  return (has_sections && anyrtttl::compile(iMelody.c_str(), NULL, 0) > 0);
+}
+
+static bool addMelody(std::vector<catalog_item_t> & ioItems, const std::string & iMelody, byte iFormat)
+{
+  catalog_item_t item;
+  item.name = trim(iMelody.substr(0, iMelody.find(':')));
+  item.hash = anyrtttl::catalog::getNameHash(item.name.c_str());
+
+  if (iFormat == anyrtttl::RTTTL_FORMAT_TEXT)
+  {
+    item.data.assign(iMelody.begin(), iMelody.end());
+    item.data.push_back('\0');
+  }
+  else
+  {
+    byte bits = (iFormat == anyrtttl::RTTTL_FORMAT_BINARY10 ? 10 : 16);
+    uint16_t size = anyrtttl::encode(iMelody.c_str(), &anyrtttl::readCharMem, bits, NULL, 0);
+    if (size == 0)
+    {
+      fprintf(stderr, "Failed to encode melody '%s'.\n", item.name.c_str());
+      return false;
+    }
+    item.data.resize(size);
+    anyrtttl::encode(iMelody.c_str(), &anyrtttl::readCharMem, bits, &item.data[0], size);
+  }
+
+  if (item.data.size() > 0xFFFF)
+  {
+    fprintf(stderr, "Melody '%s' is too large.\n", item.name.c_str());
+    return false;
+  }
+
+  ioItems.push_back(item);
+  return true;
+}
+
+static bool compareItems(const catalog_item_t & a, const catalog_item_t & b)
+{
+  return a.hash < b.hash;
+}
+
+static void appendUInt16(std::vector<unsigned char> & ioBuffer, uint16_t iValue)
+{
+  ioBuffer.push_back((unsigned char)(iValue & 0xFF));
+  ioBuffer.push_back((unsigned char)(iValue >> 8));
+}
+
+static void appendUInt32(std::vector<unsigned char> & ioBuffer, uint32_t iValue)
+{
+  appendUInt16(ioBuffer, (uint16_t)(iValue & 0xFFFF));
+  appendUInt16(ioBuffer, (uint16_t)(iValue >> 16));
+}
+
+// Builds the catalog blob. Items must be sorted by hash.
+static std::vector<unsigned char> buildCatalog(const std::vector<catalog_item_t> & iItems, byte iFormat)
+{
+  std::vector<unsigned char> catalog;
+  catalog.push_back('R');
+  catalog.push_back('T');
+  catalog.push_back('C');
+  catalog.push_back('1');
+  appendUInt16(catalog, (uint16_t)iItems.size());
+  appendUInt16(catalog, 0);
+
+  uint32_t offset = anyrtttl::catalog::CATALOG_HEADER_SIZE + (uint32_t)iItems.size() * anyrtttl::catalog::CATALOG_ENTRY_SIZE;
+  for(size_t i=0; i<iItems.size(); i++)
+  {
+    appendUInt32(catalog, iItems[i].hash);
+    appendUInt32(catalog, offset);
+    appendUInt16(catalog, (uint16_t)iItems[i].data.size());
+    catalog.push_back(iFormat);
+    catalog.push_back(0);
+    offset += (uint32_t)iItems[i].data.size();
+  }
+
+  for(size_t i=0; i<iItems.size(); i++)
+    catalog.insert(catalog.end(), iItems[i].data.begin(), iItems[i].data.end());
+
+  return catalog;
+}
+
+static void writeSource(FILE * f, const std::string & iName, const std::vector<catalog_item_t> & iItems, const std::vector<unsigned char> & iCatalog)
+{
+  std::string prefix = getIdentifier(iName);
+
+  fprintf(f, "// RTTTL catalog generated by anyrtttl_catalog.\n");
+  fprintf(f, "// %d melodies, %d bytes.\n", (int)iItems.size(), (int)iCatalog.size());
+  fprintf(f, "\n");
+  fprintf(f, "// Melody ids. Use with anyrtttl::catalog::getById().\n");
+  for(size_t i=0; i<iItems.size(); i++)
+    fprintf(f, "static const uint16_t %s_%s = %d; // %s\n", prefix.c_str(), getIdentifier(iItems[i].name).c_str(), (int)i, iItems[i].name.c_str());
+  fprintf(f, "\n");
+  fprintf(f, "const unsigned char %s[] PROGMEM = {", iName.c_str());
+  for(size_t i=0; i<iCatalog.size(); i++)
+  {
+    if (i > 0)
+      fprintf(f, ",");
+    if (i % 16 == 0)
+      fprintf(f, "\n  ");
+    else
+      fprintf(f, " ");
+    fprintf(f, "0x%02X", iCatalog[i]);
+  }
+  fprintf(f, "\n};\n");
+}
+
+int main(int argc, char * argv[])
+{
+  byte format = anyrtttl::RTTTL_FORMAT_TEXT;
+  std::string name = "melodies_catalog";
+  const char * output_path = NULL;
+  const char * bin_path = NULL;
+  const char * file_path = NULL;
+  std::vector<std::string> melodies;
+
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    bool has_value = (i+1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--format" && has_value)
+    {
+      std::string value = argv[++i];
+      if (value == "text")
+        format = anyrtttl::RTTTL_FORMAT_TEXT;
+      else if (value == "binary10")
+        format = anyrtttl::RTTTL_FORMAT_BINARY10;
+      else if (value == "binary16")
+        format = anyrtttl::RTTTL_FORMAT_BINARY16;
+      else
+      {
+        fprintf(stderr, "Unknown format '%s'.\n", value.c_str());
+        return 1;
+      }
+    }
+    else if (arg == "--name" && has_value)
+      name = argv[++i];
+    else if (arg == "--output" && has_value)
+      output_path = argv[++i];
+    else if (arg == "--bin" && has_value)
+      bin_path = argv[++i];
+    else if (arg == "--file" && has_value)
+      file_path = argv[++i];
+    else
+      melodies.push_back(arg);
+  }
+
+  if (file_path == NULL && melodies.empty())
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  // Read melodies from a file
+  if (file_path != NULL)
+  {
+    std::ifstream file;
+    std::istream * input = &std::cin;
+    if (strcmp(file_path, "-") != 0)
+    {
+      file.open(file_path);
+      if (!file.is_open())
+      {
+        fprintf(stderr, "Failed to open file '%s'.\n", file_path);
+        return 1;
+      }
+      input = &file;
+    }
+
+    std::string line;
+    while (std::getline(*input, line))
+      melodies.push_back(line);
+  }
+
+  std::vector<catalog_item_t> items;
+  for(size_t i=0; i<melodies.size(); i++)
+  {
+    std::string melody = trim(melodies[i]);
+    if (!isMelody(melody))
+      continue; // not an RTTTL melody
+    if (!addMelody(items, melody, format))
+      return 1;
+  }
+  if (items.empty() || items.size() > 0xFFFF)
+  {
+    fprintf(stderr, "Invalid number of melodies: %d.\n", (int)items.size());
+    return 1;
+  }
+
+  // Sort by hash for binary searches and reject duplicated hashes
+  std::stable_sort(items.begin(), items.end(), &compareItems);
+  for(size_t i=1; i<items.size(); i++)
+  {
+    if (items[i].hash == items[i-1].hash)
+    {
+      if (items[i].name == items[i-1].name)
+        fprintf(stderr, "Duplicated melody name '%s'.\n", items[i].name.c_str());
+      else
+        fprintf(stderr, "Melody names '%s' and '%s' have the same hash. Rename one of the melodies.\n", items[i-1].name.c_str(), items[i].name.c_str());
+      return 1;
+    }
+  }
+
+  std::vector<unsigned char> catalog = buildCatalog(items, format);
+
+  FILE * f = stdout;
+  if (output_path != NULL)
+  {
+    f = fopen(output_path, "w");
+    if (f == NULL)
+    {
+      fprintf(stderr, "Failed to open file '%s'.\n", output_path);
+      return 1;
+    }
+  }
+  writeSource(f, name, items, catalog);
+  if (f != stdout)
+    fclose(f);
+
+  if (bin_path != NULL)
+  {
+    FILE * bin = fopen(bin_path, "wb");
+    if (bin == NULL || fwrite(&catalog[0], 1, catalog.size(), bin) != catalog.size())
+    {
+      fprintf(stderr, "Failed to write file '%s'.\n", bin_path);
+      if (bin != NULL)
+        fclose(bin);
+      return 1;
+    }
+    fclose(bin);
+  }
+
+  fprintf(stderr, "Cataloged %d melodies, %d bytes.\n", (int)items.size(), (int)catalog.size());
+  return 0;
+}
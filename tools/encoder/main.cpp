@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_encoder: Converts RTTTL text melodies to the binary RTTTL format.
+// The output is C source code ready to be pasted in an Arduino sketch.
+// See BinaryRTTTL.md for details.
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+#include "binrtttl.h"
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [--bits 10|16] [--file <path>] [melody...]\n", iName);
+  printf("Converts RTTTL text melodies to the binary RTTTL format.\n");
+  printf("\n");
+  printf("  --bits N       Number of bits per note. Must be 10 or 16. Default is 10.\n");
+  printf("  --file <path>  Read melodies from a text file, one melody per line.\n");
+  printf("                 Lines that are not RTTTL melodies are ignored.\n");
+  printf("                 Use '-' to read from standard input.\n");
+  printf("  melody         An RTTTL melody. For example: \"tetris:d=4,o=5,b=160:e6,8b,8c6\"\n");
+}
+
+static std::string trim(const std::string & iValue)
+{
+  static const char * WHITESPACES = " \t\r\n";
+  size_t first = iValue.find_first_not_of(WHITESPACES);
+  if (first == std::string::npos)
+    return "";
+  size_t last = iValue.find_last_not_of(WHITESPACES);
+  return iValue.substr(first, last - first + 1);
+}
+
+// Returns a valid C identifier from the name of a melody.
+static std::string getIdentifier(const std::string & iMelody, int iBitsPerNote)
+{
+  std::string name = iMelody.substr(0, iMelody.find(':'));
+  std::string identifier;
+  for(size_t i=0; i<name.size(); i++)
+  {
+    char c = name[i];
+    if (c >= 'A' && c <= 'Z')
+      c += ('a' - 'A');
+    if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_')
+      identifier += c;
+    else if (!identifier.empty() && identifier[identifier.size()-1] != '_')
+      identifier += '_';
+  }
+  if (identifier.empty() || (identifier[0] >= '0' && identifier[0] <= '9'))
+    identifier.insert(0, "melody_");
+  identifier += std::to_string(iBitsPerNote);
+  return identifier;
+}
+
+static bool encodeMelody(const std::string & iMelody, int iBitsPerNote)
+{
+  uint16_t size = anyrtttl::encode(iMelody.c_str(), &anyrtttl::readCharMem, (byte)iBitsPerNote, NULL, 0);
+  if (size == 0)
+    return false;
+
+  std::vector<unsigned char> buffer(size);
+  size = anyrtttl::encode(iMelody.c_str(), &anyrtttl::readCharMem, (byte)iBitsPerNote, &buffer[0], size);
+  if (size == 0)
+    return false;
+
+  printf("//RTTTL %d bits binary format for the following: %s\n", iBitsPerNote, iMelody.c_str());
+  printf("//Size: %d bytes (text: %d bytes)\n", (int)size, (int)iMelody.size() + 1);
+  printf("const unsigned char %s[] PROGMEM = {", getIdentifier(iMelody, iBitsPerNote).c_str());
+  for(uint16_t i=0; i<size; i++)
+  {
+    if (i > 0)
+      printf(", ");
+    printf("0x%02X", buffer[i]);
+  }
+  printf("};\n");
+  return true;
+}
+
+int main(int argc, char * argv[])
+{
+  int bits = 10;
+  const char * file_path = NULL;
+  std::vector<std::string> melodies;
+
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--bits" && i+1 < argc)
+    {
+      bits = atoi(argv[++i]);
+    }
+    else if (arg == "--file" && i+1 < argc)
+    {
+      file_path = argv[++i];
+    }
+    else
+    {
+      melodies.push_back(arg);
+    }
+  }
+
+  if (bits != 10 && bits != 16)
+  {
+    fprintf(stderr, "Invalid number of bits per note: %d. Must be 10 or 16.\n", bits);
+    return 1;
+  }
+  if (file_path == NULL && melodies.empty())
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  // Encode melodies from the command line
+  int errors = 0;
+  for(size_t i=0; i<melodies.size(); i++)
+  {
+    std::string melody = trim(melodies[i]);
+    if (!encodeMelody(melody, bits))
+    {
+      fprintf(stderr, "Failed to encode melody '%s'.\n", melody.c_str());
+      errors++;
+    }
+  }
+
+  // Encode melodies from a file
+  if (file_path != NULL)
+  {
+    std::ifstream file;
+    std::istream * input = &std::cin;
+    if (strcmp(file_path, "-") != 0)
+    {
+      file.open(file_path);
+      if (!file.is_open())
+      {
+        fprintf(stderr, "Failed to open file '%s'.\n", file_path);
+        return 1;
+      }
+      input = &file;
+    }
+
+    int count = 0;
+    std::string line;
+    while (std::getline(*input, line))
+    {
+      line = trim(line);
+      if (line.empty())
+        continue;
+      if (encodeMelody(line, bits))
+        count++;
+    }
+    fprintf(stderr, "Encoded %d melodies from '%s'.\n", count, file_path);
+  }
+
+  return (errors == 0 ? 0 : 1);
+}
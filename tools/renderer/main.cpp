@@ -0,0 +1,289 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_render: Renders RTTTL melodies to WAV files.
+// The size and checksum of each file can be compared with a golden log to detect changes in the rendering of a whole corpus.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include "rtttl_renderer.h"
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [options] [--output <file.wav>] melody\n", iName);
+  printf("       %s [options] --file <path> [--output-dir <directory>]\n", iName);
+  printf("Renders RTTTL melodies to 16 bits mono WAV files.\n");
+  printf("\n");
+  printf("  --rate N               Sample rate in Hz. Default is 44100.\n");
+  printf("  --waveform square|blep Waveform of the tones. Default is square.\n");
+  printf("  --amplitude A          Amplitude of the tones, from 0.0 to 1.0. Default is 0.5.\n");
+  printf("  --output <file.wav>    Output file of a single melody. Default is <name>.wav.\n");
+  printf("  --file <path>          Read melodies from a text file, one melody per line. Can be repeated.\n");
+  printf("                         Lines that are not RTTTL melodies are ignored.\n");
+  printf("                         Use '-' to read from standard input.\n");
+  printf("  --output-dir <dir>     Output directory of the melodies read from a file.\n");
+  printf("  --log <file>           Write the number of samples and the checksum of each WAV file to a log.\n");
+  printf("  --expected <file>      Compare the log with a golden log. Returns 1 when they are different.\n");
+}
+
+static std::string trim(const std::string & iValue)
+{
+  static const char * WHITESPACES = " \t\r\n";
+  size_t first = iValue.find_first_not_of(WHITESPACES);
+  if (first == std::string::npos)
+    return "";
+  size_t last = iValue.find_last_not_of(WHITESPACES);
+  return iValue.substr(first, last - first + 1);
+}
+
+// Returns a file name from the name of a melody.
+static std::string getFileName(const std::string & iMelody)
+{
+  std::string name = trim(iMelody.substr(0, iMelody.find(':')));
+  std::string file_name;
+  for(size_t i=0; i<name.size(); i++)
+  {
+    char c = name[i];
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')
+      file_name += c;
+    else
+      file_name += '_';
+  }
+  if (file_name.empty())
+    file_name = "melody";
+  return file_name + ".wav";
+}
+
+static bool readFile(const char * iPath, std::string & oContent)
+{
+  std::ifstream file(iPath, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  oContent = buffer.str();
+  return true;
+}
+
+// Returns the FNV-1a hash of the given bytes.
+static uint32_t getChecksum(const std::string & iContent)
+{
+  uint32_t hash = 2166136261u;
+  for(size_t i=0; i<iContent.size(); i++)
+  {
+    hash ^= (unsigned char)iContent[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Prints the first line that differs between two logs.
+static void printFirstDifference(const std::string & iExpected, const std::string & iActual)
+{
+  std::istringstream expected(iExpected);
+  std::istringstream actual(iActual);
+  std::string expected_line;
+  std::string actual_line;
+  for(int line=1; ; line++)
+  {
+    bool has_expected = (bool)std::getline(expected, expected_line);
+    bool has_actual = (bool)std::getline(actual, actual_line);
+    if (!has_expected && !has_actual)
+      return;
+    if (!has_expected || !has_actual || expected_line != actual_line)
+    {
+      fprintf(stderr, "First difference at line %d:\n", line);
+      fprintf(stderr, "  expected: %s\n", has_expected ? expected_line.c_str() : "<end of log>");
+      fprintf(stderr, "  actual:   %s\n", has_actual ? actual_line.c_str() : "<end of log>");
+      return;
+    }
+  }
+}
+
+// Renders a melody to a WAV file and adds the number of samples and the checksum of the file to the log.
+static bool renderMelody(const std::string & iMelody, const anyrtttl::renderer::render_options_t & iOptions, const std::string & iPath, std::string & oLog)
+{
+  std::vector<int16_t> samples;
+  if (!anyrtttl::renderer::render(iMelody.c_str(), iOptions, samples))
+    return false;
+  if (!anyrtttl::renderer::writeWav(iPath.c_str(), samples.empty() ? NULL : &samples[0], samples.size(), iOptions.sampleRate))
+    return false;
+
+  std::string content;
+  if (!readFile(iPath.c_str(), content))
+    return false;
+  size_t separator = iPath.find_last_of("/\\");
+  std::string file_name = (separator == std::string::npos ? iPath : iPath.substr(separator + 1));
+  char line[256];
+  snprintf(line, sizeof(line), "%s: %u samples, %u bytes, checksum %08x\n", file_name.c_str(), (unsigned int)samples.size(), (unsigned int)content.size(), (unsigned int)getChecksum(content));
+  oLog += line;
+  return true;
+}
+
+// Renders the melodies of a text file, one melody per line, to WAV files in the given directory.
+static bool renderFile(const char * iPath, const anyrtttl::renderer::render_options_t & iOptions, const std::string & iOutputDir, std::string & oLog)
+{
+  std::ifstream file;
+  std::istream * input = &std::cin;
+  if (strcmp(iPath, "-") != 0)
+  {
+    file.open(iPath);
+    if (!file.is_open())
+    {
+      fprintf(stderr, "Failed to open file '%s'.\n", iPath);
+      return false;
+    }
+    input = &file;
+  }
+
+  int count = 0;
+  int errors = 0;
+  std::string line;
+  while (std::getline(*input, line))
+  {
+    line = trim(line);
+    bool has_sections = (line.find(':') != std::string::npos && line.find(':') != line.rfind(':'));
+    if (!has_sections || anyrtttl::compile(line.c_str(), NULL, 0) == 0)
+      continue; // not an RTTTL melody
+
+    std::string path = iOutputDir + getFileName(line);
+    if (renderMelody(line, iOptions, path, oLog))
+    {
+      count++;
+    }
+    else
+    {
+      fprintf(stderr, "Failed to write file '%s'.\n", path.c_str());
+      errors++;
+    }
+  }
+  fprintf(stderr, "Rendered %d melodies from '%s'.\n", count, iPath);
+  return (errors == 0);
+}
+
+int main(int argc, char * argv[])
+{
+  anyrtttl::renderer::render_options_t options = anyrtttl::renderer::getDefaultOptions();
+  std::vector<const char *> file_paths;
+  std::string output_path;
+  std::string output_dir;
+  std::string melody;
+  const char * log_path = NULL;
+  const char * expected_path = NULL;
+
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    bool has_value = (i+1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--rate" && has_value)
+      options.sampleRate = (uint32_t)atol(argv[++i]);
+    else if (arg == "--amplitude" && has_value)
+      options.amplitude = (float)atof(argv[++i]);
+    else if (arg == "--waveform" && has_value)
+    {
+      std::string waveform = argv[++i];
+      if (waveform == "square")
+        options.waveform = anyrtttl::renderer::WAVEFORM_SQUARE;
+      else if (waveform == "blep")
+        options.waveform = anyrtttl::renderer::WAVEFORM_BANDLIMITED;
+      else
+      {
+        fprintf(stderr, "Unknown waveform '%s'.\n", waveform.c_str());
+        return 1;
+      }
+    }
+    else if (arg == "--output" && has_value)
+      output_path = argv[++i];
+    else if (arg == "--file" && has_value)
+      file_paths.push_back(argv[++i]);
+    else if (arg == "--output-dir" && has_value)
+      output_dir = argv[++i];
+    else if (arg == "--log" && has_value)
+      log_path = argv[++i];
+    else if (arg == "--expected" && has_value)
+      expected_path = argv[++i];
+    else
+      melody = arg;
+  }
+
+  if (options.sampleRate == 0)
+  {
+    fprintf(stderr, "Invalid sample rate.\n");
+    return 1;
+  }
+  if (file_paths.empty() && melody.empty())
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::string log;
+
+  // Render a melody from the command line
+  if (!melody.empty())
+  {
+    melody = trim(melody);
+    if (output_path.empty())
+      output_path = getFileName(melody);
+    if (!renderMelody(melody, options, output_path, log))
+    {
+      fprintf(stderr, "Failed to render melody '%s' to file '%s'.\n", melody.c_str(), output_path.c_str());
+      return 1;
+    }
+  }
+
+  // Render melodies from files
+  if (!output_dir.empty() && output_dir[output_dir.size()-1] != '/')
+    output_dir += '/';
+  for(size_t i=0; i<file_paths.size(); i++)
+  {
+    if (!renderFile(file_paths[i], options, output_dir, log))
+      return 1;
+  }
+
+  if (log_path != NULL)
+  {
+    std::ofstream output(log_path, std::ios::binary);
+    if (!output.is_open())
+    {
+      fprintf(stderr, "Unable to write file '%s'.\n", log_path);
+      return 1;
+    }
+    output << log;
+  }
+
+  if (expected_path != NULL)
+  {
+    std::string expected;
+    if (!readFile(expected_path, expected))
+    {
+      fprintf(stderr, "Unable to open file '%s'.\n", expected_path);
+      return 1;
+    }
+    if (expected != log)
+    {
+      fprintf(stderr, "The log is different from '%s'.\n", expected_path);
+      printFirstDifference(expected, log);
+      return 1;
+    }
+    fprintf(stderr, "The log matches '%s'.\n", expected_path);
+  }
+
+  return 0;
+}
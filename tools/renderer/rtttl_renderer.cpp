@@ -0,0 +1,217 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "rtttl_renderer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace anyrtttl
+{
+namespace renderer
+{
+
+// Length in milliseconds of the silence after each tone.
+// nonblocking::play() waits duration+1 milliseconds after a tone and duration milliseconds after a pause.
+static const uint32_t TONE_GAP_MS = 1;
+
+render_options_t getDefaultOptions()
+{
+  render_options_t options;
+  options.sampleRate = 44100;
+  options.waveform = WAVEFORM_SQUARE;
+  options.amplitude = 0.5f;
+  return options;
+}
+
+// Returns the index of the first sample at the given time.
+// Computed from the absolute time to prevent rounding errors from accumulating over a melody.
+static inline size_t getSampleIndex(uint64_t iTimeMs, uint32_t iSampleRate)
+{
+  return (size_t)((iTimeMs * iSampleRate) / 1000);
+}
+
+static inline uint32_t getEventLengthMs(const rtttl_note_event_t & e)
+{
+  return (e.frequency != NOTE_SILENT ? e.duration + TONE_GAP_MS : e.duration);
+}
+
+size_t getSamplesCount(const rtttl_note_event_t * iEvents, uint16_t iEventsCount, uint32_t iSampleRate)
+{
+  uint64_t totalMs = 0;
+  for(uint16_t i=0; i<iEventsCount; i++)
+    totalMs += getEventLengthMs(iEvents[i]);
+  return getSampleIndex(totalMs, iSampleRate);
+}
+
+// The oscillators below use a 32 bits fixed point phase accumulator.
+// The phase of sample i is computed from i instead of the previous sample.
+// The loops have no loop-carried dependency and can be auto-vectorized. GCC only vectorizes them at -O3
+// which is the optimization level of the anyrtttl_render target. See CMakeLists.txt.
+
+static void renderSquare(int16_t * oSamples, size_t iCount, uint32_t iPhaseStep, int16_t iAmplitude)
+{
+  const int16_t high = iAmplitude;
+  const int16_t low = (int16_t)-iAmplitude;
+  for(size_t i=0; i<iCount; i++)
+  {
+    uint32_t phase = (uint32_t)i * iPhaseStep;
+    oSamples[i] = (phase & 0x80000000u) ? low : high;
+  }
+}
+
+// PolyBLEP residual for a discontinuity at phase 0. See Valimaki & Huovilainen, 2007.
+static inline float polyBlep(float t, float dt)
+{
+  float x1 = t / dt;
+  float x2 = (t - 1.0f) / dt;
+  float r1 = x1 + x1 - x1*x1 - 1.0f;
+  float r2 = x2*x2 + x2 + x2 + 1.0f;
+  return (t < dt ? r1 : (t > 1.0f - dt ? r2 : 0.0f));
+}
+
+static void renderBandLimited(int16_t * oSamples, size_t iCount, uint32_t iPhaseStep, int16_t iAmplitude)
+{
+  static const float PHASE_SCALE = 1.0f / 16777216.0f; // 2^-24
+  const float dt = (float)(iPhaseStep >> 8) * PHASE_SCALE;
+  const float amplitude = (float)iAmplitude;
+  for(size_t i=0; i<iCount; i++)
+  {
+    uint32_t phase = (uint32_t)i * iPhaseStep;
+    float t = (float)(int32_t)(phase >> 8) * PHASE_SCALE;                 // phase in [0, 1)
+    float t2 = (float)(int32_t)((phase + 0x80000000u) >> 8) * PHASE_SCALE; // phase shifted by 1/2
+    float value = (t < 0.5f ? 1.0f : -1.0f) + polyBlep(t, dt) - polyBlep(t2, dt);
+    oSamples[i] = (int16_t)(value * amplitude);
+  }
+}
+
+size_t render(const rtttl_note_event_t * iEvents, uint16_t iEventsCount, const render_options_t & iOptions, int16_t * oSamples, size_t iMaxSamples)
+{
+  if (iEvents == NULL || oSamples == NULL || iOptions.sampleRate == 0)
+    return 0;
+
+  float amplitude = iOptions.amplitude;
+  if (amplitude < 0.0f) amplitude = 0.0f;
+  if (amplitude > 1.0f) amplitude = 1.0f;
+  const int16_t amplitude16 = (int16_t)(amplitude * 32767.0f);
+
+  uint64_t timeMs = 0;
+  size_t written = 0;
+  for(uint16_t i=0; i<iEventsCount && written < iMaxSamples; i++)
+  {
+    const rtttl_note_event_t & e = iEvents[i];
+    size_t first = getSampleIndex(timeMs, iOptions.sampleRate);
+    size_t toneEnd = getSampleIndex(timeMs + e.duration, iOptions.sampleRate);
+    timeMs += getEventLengthMs(e);
+    size_t last = getSampleIndex(timeMs, iOptions.sampleRate);
+
+    if (last > iMaxSamples)
+      last = iMaxSamples;
+    if (toneEnd > last)
+      toneEnd = last;
+
+    size_t toneCount = 0;
+    if (e.frequency != NOTE_SILENT && e.frequency < iOptions.sampleRate / 2)
+    {
+      toneCount = toneEnd - first;
+      uint32_t phaseStep = (uint32_t)(((uint64_t)e.frequency << 32) / iOptions.sampleRate);
+      if (iOptions.waveform == WAVEFORM_BANDLIMITED)
+        renderBandLimited(oSamples + first, toneCount, phaseStep, amplitude16);
+      else
+        renderSquare(oSamples + first, toneCount, phaseStep, amplitude16);
+    }
+
+    // silence
+    memset(oSamples + first + toneCount, 0, (last - first - toneCount) * sizeof(int16_t));
+    written = last;
+  }
+
+  return written;
+}
+
+bool render(const char * iBuffer, const render_options_t & iOptions, std::vector<int16_t> & oSamples)
+{
+  oSamples.clear();
+
+  uint16_t count = compile(iBuffer, NULL, 0);
+  if (count == 0)
+    return false;
+
+  std::vector<rtttl_note_event_t> events(count);
+  count = compile(iBuffer, &events[0], count);
+
+  oSamples.resize(getSamplesCount(&events[0], count, iOptions.sampleRate));
+  if (oSamples.empty())
+    return true;
+  size_t written = render(&events[0], count, iOptions, &oSamples[0], oSamples.size());
+  oSamples.resize(written);
+  return true;
+}
+
+static void writeUInt16(FILE * f, uint16_t value)
+{
+  unsigned char bytes[2] = { (unsigned char)(value & 0xFF), (unsigned char)(value >> 8) };
+  fwrite(bytes, 1, sizeof(bytes), f);
+}
+
+static void writeUInt32(FILE * f, uint32_t value)
+{
+  unsigned char bytes[4] = { (unsigned char)(value & 0xFF), (unsigned char)((value >> 8) & 0xFF), (unsigned char)((value >> 16) & 0xFF), (unsigned char)(value >> 24) };
+  fwrite(bytes, 1, sizeof(bytes), f);
+}
+
+bool writeWav(const char * iPath, const int16_t * iSamples, size_t iCount, uint32_t iSampleRate)
+{
+  static const uint16_t CHANNELS = 1;
+  static const uint16_t BITS_PER_SAMPLE = 16;
+  static const uint16_t BLOCK_ALIGN = CHANNELS * BITS_PER_SAMPLE / 8;
+
+  if (iPath == NULL || (iSamples == NULL && iCount > 0) || iCount > (0xFFFFFFFFu - 36) / BLOCK_ALIGN)
+    return false;
+
+  FILE * f = fopen(iPath, "wb");
+  if (f == NULL)
+    return false;
+
+  uint32_t dataSize = (uint32_t)(iCount * BLOCK_ALIGN);
+
+  // RIFF header
+  fwrite("RIFF", 1, 4, f);
+  writeUInt32(f, 36 + dataSize);
+  fwrite("WAVE", 1, 4, f);
+
+  // format chunk
+  fwrite("fmt ", 1, 4, f);
+  writeUInt32(f, 16);                               // chunk size
+  writeUInt16(f, 1);                                // PCM
+  writeUInt16(f, CHANNELS);
+  writeUInt32(f, iSampleRate);
+  writeUInt32(f, iSampleRate * BLOCK_ALIGN);        // byte rate
+  writeUInt16(f, BLOCK_ALIGN);
+  writeUInt16(f, BITS_PER_SAMPLE);
+
+  // data chunk
+  fwrite("data", 1, 4, f);
+  writeUInt32(f, dataSize);
+  std::vector<unsigned char> data(dataSize);
+  for(size_t i=0; i<iCount; i++)
+  {
+    uint16_t sample = (uint16_t)iSamples[i];
+    data[2*i+0] = (unsigned char)(sample & 0xFF);
+    data[2*i+1] = (unsigned char)(sample >> 8);
+  }
+  if (dataSize > 0)
+    fwrite(&data[0], 1, dataSize, f);
+
+  bool success = (ferror(f) == 0);
+  if (fclose(f) != 0)
+    success = false;
+  return success;
+}
+
+}; //renderer namespace
+}; //anyrtttl namespace
@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_RENDERER_H
+#define RTTTL_RENDERER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+namespace renderer
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines the waveform used for rendering tones.
+ ****************************************************************************/
+enum waveform_t {
+  WAVEFORM_SQUARE = 0,        // a naive square wave. Matches the output of tone() on a buzzer.
+  WAVEFORM_BANDLIMITED,       // a band-limited square wave (PolyBLEP). Less aliasing at high frequencies.
+};
+
+/****************************************************************************
+ * Description:
+ *   Defines the rendering options.
+ ****************************************************************************/
+struct render_options_t {
+  uint32_t sampleRate;        // number of samples per second.
+  waveform_t waveform;        // waveform of the tones.
+  float amplitude;            // amplitude of the tones. Ranges from 0.0 to 1.0.
+};
+
+/****************************************************************************
+ * Description:
+ *   Returns the default rendering options: 44100 Hz square wave at half amplitude.
+ ****************************************************************************/
+render_options_t getDefaultOptions();
+
+/****************************************************************************
+ * Description:
+ *   Returns the number of samples required for rendering the given notes.
+ *   The timing of notes matches nonblocking::play(): a tone of duration D
+ *   is followed by 1 ms of silence and a pause of duration D is silent for D ms.
+ * Parameters:
+ *   iEvents:      The notes of a melody. See anyrtttl::compile().
+ *   iEventsCount: The number of notes in iEvents.
+ *   iSampleRate:  The number of samples per second.
+ ****************************************************************************/
+size_t getSamplesCount(const rtttl_note_event_t * iEvents, uint16_t iEventsCount, uint32_t iSampleRate);
+
+/****************************************************************************
+ * Description:
+ *   Renders the given notes as 16 bits signed mono PCM samples.
+ * Parameters:
+ *   iEvents:      The notes of a melody. See anyrtttl::compile().
+ *   iEventsCount: The number of notes in iEvents.
+ *   iOptions:     The rendering options.
+ *   oSamples:     The output samples buffer.
+ *   iMaxSamples:  The size of oSamples in samples.
+ * Returns:
+ *   Returns the number of samples written to oSamples.
+ ****************************************************************************/
+size_t render(const rtttl_note_event_t * iEvents, uint16_t iEventsCount, const render_options_t & iOptions, int16_t * oSamples, size_t iMaxSamples);
+
+/****************************************************************************
+ * Description:
+ *   Renders an RTTTL text melody as 16 bits signed mono PCM samples.
+ * Parameters:
+ *   iBuffer:  The RTTTL melody.
+ *   iOptions: The rendering options.
+ *   oSamples: The output samples.
+ * Returns:
+ *   Returns true if the melody was rendered and false otherwise.
+ ****************************************************************************/
+bool render(const char * iBuffer, const render_options_t & iOptions, std::vector<int16_t> & oSamples);
+
+/****************************************************************************
+ * Description:
+ *   Writes 16 bits signed mono PCM samples to a WAV file.
+ * Parameters:
+ *   iPath:       The path of the output file.
+ *   iSamples:    The PCM samples.
+ *   iCount:      The number of samples in iSamples.
+ *   iSampleRate: The number of samples per second.
+ * Returns:
+ *   Returns true if the file was written and false otherwise.
+ ****************************************************************************/
+bool writeWav(const char * iPath, const int16_t * iSamples, size_t iCount, uint32_t iSampleRate);
+
+}; //renderer namespace
+}; //anyrtttl namespace
+
+#endif //RTTTL_RENDERER_H
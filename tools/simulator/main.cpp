@@ -0,0 +1,197 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_simulate: Plays RTTTL melodies on a virtual clock and prints the calls to tone() and noTone().
+// The output can be compared with a golden log to detect changes in the playback of a whole corpus.
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <chrono>
+
+#include "rtttl_simulator.h"
+
+static const byte SIMULATOR_PIN = 8;
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [options] <corpus> [<corpus> ...]\n", iName);
+  printf("Plays the RTTTL melodies of text files on a virtual clock and prints the calls to tone() and noTone().\n");
+  printf("Lines that are not RTTTL melodies are ignored.\n");
+  printf("\n");
+  printf("  --output <file>    Write the log to a file instead of the standard output.\n");
+  printf("  --expected <file>  Compare the log with a golden log. Returns 1 when they are different.\n");
+  printf("  --micros           Use the RTTTL_TIMING_MICROS timing mode.\n");
+}
+
+static std::string trim(const std::string & iValue)
+{
+  static const char * WHITESPACES = " \t\r\n";
+  size_t first = iValue.find_first_not_of(WHITESPACES);
+  if (first == std::string::npos)
+    return "";
+  size_t last = iValue.find_last_not_of(WHITESPACES);
+  return iValue.substr(first, last - first + 1);
+}
+
+// Adds the RTTTL melodies found in a text file.
+static bool loadMelodies(const char * iPath, std::vector<std::string> & oMelodies)
+{
+  std::ifstream file(iPath);
+  if (!file.is_open())
+  {
+    fprintf(stderr, "Unable to open corpus file '%s'.\n", iPath);
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    line = trim(line);
+    size_t first = line.find(':');
+    if (first == std::string::npos || line.find(':', first+1) == std::string::npos)
+      continue;
+    if (anyrtttl::compile(line.c_str(), NULL, 0) == 0)
+      continue;
+    oMelodies.push_back(line);
+  }
+  return true;
+}
+
+static bool readFile(const char * iPath, std::string & oContent)
+{
+  std::ifstream file(iPath, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  oContent = buffer.str();
+  return true;
+}
+
+// Prints the first line that differs between two logs.
+static void printFirstDifference(const std::string & iExpected, const std::string & iActual)
+{
+  std::istringstream expected(iExpected);
+  std::istringstream actual(iActual);
+  std::string expected_line;
+  std::string actual_line;
+  for(int line=1; ; line++)
+  {
+    bool has_expected = (bool)std::getline(expected, expected_line);
+    bool has_actual = (bool)std::getline(actual, actual_line);
+    if (!has_expected && !has_actual)
+      return;
+    if (!has_expected || !has_actual || expected_line != actual_line)
+    {
+      fprintf(stderr, "First difference at line %d:\n", line);
+      fprintf(stderr, "  expected: %s\n", has_expected ? expected_line.c_str() : "<end of log>");
+      fprintf(stderr, "  actual:   %s\n", has_actual ? actual_line.c_str() : "<end of log>");
+      return;
+    }
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  const char * output_path = NULL;
+  const char * expected_path = NULL;
+  bool micros = false;
+  std::vector<const char *> corpus;
+
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    bool has_value = (i+1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--output" && has_value)
+      output_path = argv[++i];
+    else if (arg == "--expected" && has_value)
+      expected_path = argv[++i];
+    else if (arg == "--micros")
+      micros = true;
+    else
+      corpus.push_back(argv[i]);
+  }
+  if (corpus.empty())
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::vector<std::string> melodies;
+  for(size_t i=0; i<corpus.size(); i++)
+  {
+    if (!loadMelodies(corpus[i], melodies))
+      return 1;
+  }
+
+  anyrtttl::simulator::install();
+  if (micros)
+    anyrtttl::setTimingMode(anyrtttl::RTTTL_TIMING_MICROS);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::string log;
+  uint64_t simulated = 0;
+  size_t events = 0;
+  for(size_t i=0; i<melodies.size(); i++)
+  {
+    std::string melody_log;
+    if (!anyrtttl::simulator::simulate(SIMULATOR_PIN, melodies[i].c_str(), melody_log))
+    {
+      fprintf(stderr, "Melody '%s' did not end.\n", melodies[i].c_str());
+      return 1;
+    }
+    simulated += anyrtttl::simulator::getTime();
+    events += anyrtttl::simulator::getEvents().size();
+    log += "# " + melodies[i] + "\n" + melody_log + "\n";
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  long long elapsed = (long long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  fprintf(stderr, "Simulated %d melodies, %d events, %.1f seconds of playback in %lld us.\n",
+    (int)melodies.size(), (int)events, (double)simulated / 1000000.0, elapsed);
+
+  if (output_path != NULL)
+  {
+    std::ofstream output(output_path, std::ios::binary);
+    if (!output.is_open())
+    {
+      fprintf(stderr, "Unable to write file '%s'.\n", output_path);
+      return 1;
+    }
+    output << log;
+  }
+  else if (expected_path == NULL)
+    fwrite(log.c_str(), 1, log.size(), stdout);
+
+  if (expected_path != NULL)
+  {
+    std::string expected;
+    if (!readFile(expected_path, expected))
+    {
+      fprintf(stderr, "Unable to open file '%s'.\n", expected_path);
+      return 1;
+    }
+    if (expected != log)
+    {
+      fprintf(stderr, "The log is different from '%s'.\n", expected_path);
+      printFirstDifference(expected, log);
+      return 1;
+    }
+    fprintf(stderr, "The log matches '%s'.\n", expected_path);
+  }
+  return 0;
+}
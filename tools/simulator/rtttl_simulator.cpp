@@ -0,0 +1,147 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#include "rtttl_simulator.h"
+
+#include <stdio.h>
+
+namespace anyrtttl
+{
+namespace simulator
+{
+
+static uint64_t gVirtualMicros = 0;
+static std::vector<sim_event_t> gEvents;
+
+static void recordTone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+  sim_event_t e = { gVirtualMicros, SIM_EVENT_TONE, pin, frequency, duration };
+  gEvents.push_back(e);
+}
+
+static void recordNoTone(uint8_t pin)
+{
+  sim_event_t e = { gVirtualMicros, SIM_EVENT_NOTONE, pin, 0, 0 };
+  gEvents.push_back(e);
+}
+
+// millis() and micros() wrap around like on a board.
+static unsigned long virtualMillis()
+{
+  return (unsigned long)(uint32_t)(gVirtualMicros / 1000);
+}
+
+static unsigned long virtualMicros()
+{
+  return (unsigned long)(uint32_t)gVirtualMicros;
+}
+
+void install()
+{
+  setToneFunction(&recordTone);
+  setNoToneFunction(&recordNoTone);
+  setMillisFunction(&virtualMillis);
+  setMicrosFunction(&virtualMicros);
+  reset();
+}
+
+void reset()
+{
+  gVirtualMicros = 0;
+  gEvents.clear();
+}
+
+uint64_t getTime()
+{
+  return gVirtualMicros;
+}
+
+void advance(uint64_t iMicros)
+{
+  gVirtualMicros += iMicros;
+}
+
+// Returns the number of microseconds until the end of the current note of c.
+static uint64_t getTimeToNextNote(const rtttl_context_t & c)
+{
+  unsigned long now = detail::getTime();
+  unsigned long next = detail::getNextNoteTime(c);
+  if (!detail::isTimeBefore(now, next))
+    return 0;
+  uint64_t remaining = (uint32_t)(next - now);
+  if (gTimingMode == RTTTL_TIMING_MICROS)
+    return remaining;
+
+  // millis() changes on the next multiple of 1000 microseconds
+  return remaining * 1000 - (gVirtualMicros % 1000);
+}
+
+bool run(rtttl_context_t * iContexts, size_t iCount, uint32_t iMaxRounds)
+{
+  for(uint32_t round=0; round<iMaxRounds; round++)
+  {
+    bool playing = false;
+    bool paused = false;
+    uint64_t jump = 0;
+    for(size_t i=0; i<iCount; i++)
+    {
+      rtttl_context_t & c = iContexts[i];
+      nonblocking::play(c);
+      if (!nonblocking::isPlaying(c))
+        continue;
+      if (c.paused)
+      {
+        paused = true; // nothing resumes a melody while simulating
+        continue;
+      }
+
+      uint64_t remaining = getTimeToNextNote(c);
+      if (!playing || remaining < jump)
+        jump = remaining;
+      playing = true;
+    }
+    if (!playing)
+      return !paused;
+    gVirtualMicros += jump;
+  }
+  return false;
+}
+
+const std::vector<sim_event_t> & getEvents()
+{
+  return gEvents;
+}
+
+std::string toString(const std::vector<sim_event_t> & iEvents)
+{
+  std::string log;
+  char line[64];
+  for(size_t i=0; i<iEvents.size(); i++)
+  {
+    const sim_event_t & e = iEvents[i];
+    unsigned long ms = (unsigned long)(e.time / 1000);
+    if (e.type == SIM_EVENT_TONE)
+      snprintf(line, sizeof(line), "%06lu: tone(%u,%u,%lu);\n", ms, (unsigned)e.pin, e.frequency, e.duration);
+    else
+      snprintf(line, sizeof(line), "%06lu: noTone(%u);\n", ms, (unsigned)e.pin);
+    log += line;
+  }
+  return log;
+}
+
+bool simulate(byte iPin, const char * iBuffer, std::string & oLog)
+{
+  reset();
+  rtttl_context_t c = {0};
+  nonblocking::begin(c, iPin, iBuffer);
+  bool done = run(c);
+  oLog = toString(gEvents);
+  return done;
+}
+
+}; //simulator namespace
+}; //anyrtttl namespace
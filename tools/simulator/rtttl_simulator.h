@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+#ifndef RTTTL_SIMULATOR_H
+#define RTTTL_SIMULATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "anyrtttl.h"
+
+namespace anyrtttl
+{
+namespace simulator
+{
+
+/****************************************************************************
+ * Description:
+ *   Defines the type of a recorded event.
+ ****************************************************************************/
+enum sim_event_type_t {
+  SIM_EVENT_TONE = 0,         // tone() was called.
+  SIM_EVENT_NOTONE,           // noTone() was called.
+};
+
+/****************************************************************************
+ * Description:
+ *   Defines an event recorded by the simulator.
+ ****************************************************************************/
+struct sim_event_t {
+  uint64_t time;              // virtual time of the call, in microseconds.
+  sim_event_type_t type;      // the function that was called.
+  uint8_t pin;                // the pin of the call.
+  unsigned int frequency;     // the frequency of a tone. 0 for noTone().
+  unsigned long duration;     // the duration of a tone in milliseconds. 0 for noTone().
+};
+
+/****************************************************************************
+ * Description:
+ *   Installs the virtual clock and the event recorder as the tone(), noTone(),
+ *   millis() and micros() functions of AnyRtttl. The clock starts at 0 and
+ *   only moves with advance() or run(). Reading the clock never moves it.
+ *   Also clears the recorded events.
+ ****************************************************************************/
+void install();
+
+/****************************************************************************
+ * Description:
+ *   Sets the virtual clock to 0 and clears the recorded events.
+ ****************************************************************************/
+void reset();
+
+/****************************************************************************
+ * Description:
+ *   Returns the time of the virtual clock in microseconds.
+ ****************************************************************************/
+uint64_t getTime();
+
+/****************************************************************************
+ * Description:
+ *   Moves the virtual clock forward.
+ * Parameters:
+ *   iMicros: The number of microseconds to move forward.
+ ****************************************************************************/
+void advance(uint64_t iMicros);
+
+/****************************************************************************
+ * Description:
+ *   Plays melodies until they are done. Each context must be started with
+ *   one of the nonblocking::begin() functions. Between two rounds of calls
+ *   to nonblocking::play(), the virtual clock jumps to the end of the
+ *   earliest note being played. A melody of a few minutes is simulated
+ *   with a few calls per note.
+ * Parameters:
+ *   iContexts:   The contexts of the melodies.
+ *   iCount:      The number of contexts in iContexts.
+ *   iMaxRounds:  The maximum number of rounds of calls. Protects against
+ *                melodies that never end. See nonblocking::setLoop().
+ * Returns:
+ *   Returns true if all melodies are done. Returns false if iMaxRounds
+ *   is reached or if a melody is paused.
+ ****************************************************************************/
+bool run(rtttl_context_t * iContexts, size_t iCount, uint32_t iMaxRounds = 1000000);
+
+/****************************************************************************
+ * Description:
+ *   Plays a melody until it is done. See run() above.
+ * Parameters:
+ *   c:           The context of the melody.
+ *   iMaxRounds:  The maximum number of calls to nonblocking::play().
+ ****************************************************************************/
+inline bool run(rtttl_context_t & c, uint32_t iMaxRounds = 1000000)
+{
+  return run(&c, 1, iMaxRounds);
+}
+
+/****************************************************************************
+ * Description:
+ *   Returns the events recorded since the last call to install() or reset().
+ ****************************************************************************/
+const std::vector<sim_event_t> & getEvents();
+
+/****************************************************************************
+ * Description:
+ *   Returns the recorded events as text, one event per line:
+ *     000000: tone(8,1319,375);
+ *     000376: noTone(8);
+ *   Times are in milliseconds. The format does not depend on the timing mode
+ *   which makes logs of both modes comparable.
+ ****************************************************************************/
+std::string toString(const std::vector<sim_event_t> & iEvents);
+
+/****************************************************************************
+ * Description:
+ *   Plays an RTTTL text melody with the simulator and returns its events.
+ *   The simulator must be installed. The events of a previous melody are cleared.
+ * Parameters:
+ *   iPin:    The pin of the melody.
+ *   iBuffer: The RTTTL melody.
+ *   oLog:    The recorded events as text. See toString().
+ * Returns:
+ *   Returns true if the melody is done and false otherwise.
+ ****************************************************************************/
+bool simulate(byte iPin, const char * iBuffer, std::string & oLog);
+
+}; //simulator namespace
+}; //anyrtttl namespace
+
+#endif //RTTTL_SIMULATOR_H
@@ -0,0 +1,202 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_trace: Converts a dump of the trace buffer to a readable timeline.
+// See rtttl_trace.h for the format of a dump.
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "anyrtttl.h"
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [--hex] <file>\n", iName);
+  printf("Converts a dump of the AnyRtttl trace buffer to a readable timeline.\n");
+  printf("See rtttl_trace.h and anyrtttl::trace::dump().\n");
+  printf("\n");
+  printf("  --hex   The file is text with the dump in hexadecimal, as printed on a serial monitor.\n");
+  printf("          Only the lines made of hexadecimal digits and spaces are read.\n");
+  printf("  file    The dump file. Use '-' to read from standard input.\n");
+}
+
+static bool readBinary(std::istream & iInput, std::vector<unsigned char> & oData)
+{
+  oData.assign(std::istreambuf_iterator<char>(iInput), std::istreambuf_iterator<char>());
+  return true;
+}
+
+static bool readHex(std::istream & iInput, std::vector<unsigned char> & oData)
+{
+  std::string line;
+  while (std::getline(iInput, line))
+  {
+    std::string digits;
+    bool valid = true;
+    for(size_t i=0; i<line.size() && valid; i++)
+    {
+      char c = line[i];
+      if (isxdigit((unsigned char)c))
+        digits += c;
+      else if (!isspace((unsigned char)c))
+        valid = false;
+    }
+    if (!valid || digits.size() % 2 != 0)
+      continue; // not a line of the dump
+    for(size_t i=0; i<digits.size(); i+=2)
+      oData.push_back((unsigned char)strtoul(digits.substr(i, 2).c_str(), NULL, 16));
+  }
+  return true;
+}
+
+static uint16_t readUint16(const unsigned char * p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static const char * getEventName(byte iEvent)
+{
+  switch(iEvent)
+  {
+    case anyrtttl::RTTTL_TRACE_BEGIN:       return "BEGIN";
+    case anyrtttl::RTTTL_TRACE_NOTE_START:  return "NOTE_START";
+    case anyrtttl::RTTTL_TRACE_NOTE_END:    return "NOTE_END";
+    case anyrtttl::RTTTL_TRACE_LATE_POLL:   return "LATE_POLL";
+    case anyrtttl::RTTTL_TRACE_END:         return "END";
+    case anyrtttl::RTTTL_TRACE_STOP:        return "STOP";
+    case anyrtttl::RTTTL_TRACE_PAUSE:       return "PAUSE";
+    case anyrtttl::RTTTL_TRACE_RESUME:      return "RESUME";
+    default:                                return "UNKNOWN";
+  };
+}
+
+static const char * getFormatName(uint16_t iFormat)
+{
+  switch(iFormat)
+  {
+    case anyrtttl::RTTTL_FORMAT_TEXT:     return "text";
+    case anyrtttl::RTTTL_FORMAT_EVENTS:   return "events";
+    case anyrtttl::RTTTL_FORMAT_BINARY10: return "binary10";
+    case anyrtttl::RTTTL_FORMAT_BINARY16: return "binary16";
+    case anyrtttl::RTTTL_FORMAT_STREAM:   return "stream";
+    default:                              return "unknown";
+  };
+}
+
+static std::string getDescription(byte iEvent, uint16_t iValue, const char * iUnit)
+{
+  char buffer[64];
+  switch(iEvent)
+  {
+    case anyrtttl::RTTTL_TRACE_BEGIN:
+      snprintf(buffer, sizeof(buffer), "format %s", getFormatName(iValue));
+      break;
+    case anyrtttl::RTTTL_TRACE_NOTE_START:
+      if (iValue == 0)
+        snprintf(buffer, sizeof(buffer), "pause");
+      else
+        snprintf(buffer, sizeof(buffer), "%u Hz", (unsigned)iValue);
+      break;
+    case anyrtttl::RTTTL_TRACE_NOTE_END:
+      snprintf(buffer, sizeof(buffer), "note %u", (unsigned)iValue);
+      break;
+    case anyrtttl::RTTTL_TRACE_LATE_POLL:
+      snprintf(buffer, sizeof(buffer), "%u %s late", (unsigned)iValue, iUnit);
+      break;
+    case anyrtttl::RTTTL_TRACE_END:
+      snprintf(buffer, sizeof(buffer), "%u notes", (unsigned)iValue);
+      break;
+    default:
+      snprintf(buffer, sizeof(buffer), "next note %u", (unsigned)iValue);
+      break;
+  };
+  return buffer;
+}
+
+int main(int argc, char * argv[])
+{
+  bool hex = false;
+  const char * path = NULL;
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--hex")
+      hex = true;
+    else
+      path = argv[i];
+  }
+  if (path == NULL)
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::ifstream file;
+  std::istream * input = &std::cin;
+  if (strcmp(path, "-") != 0)
+  {
+    file.open(path, std::ios::binary);
+    if (!file.is_open())
+    {
+      fprintf(stderr, "Unable to open file '%s'.\n", path);
+      return 1;
+    }
+    input = &file;
+  }
+
+  std::vector<unsigned char> data;
+  if (hex)
+    readHex(*input, data);
+  else
+    readBinary(*input, data);
+
+  if (data.size() < anyrtttl::RTTTL_TRACE_HEADER_SIZE || data[0] != 'R' || data[1] != 'T')
+  {
+    fprintf(stderr, "Not a trace dump.\n");
+    return 1;
+  }
+  if (data[2] != 1)
+  {
+    fprintf(stderr, "Unsupported dump version %d.\n", (int)data[2]);
+    return 1;
+  }
+  const char * unit = (data[3] == anyrtttl::RTTTL_TIMING_MICROS ? "us" : "ms");
+  uint16_t count = readUint16(&data[4]);
+  uint16_t overwritten = readUint16(&data[6]);
+  if (data.size() < anyrtttl::RTTTL_TRACE_HEADER_SIZE + (size_t)count * anyrtttl::RTTTL_TRACE_RECORD_SIZE)
+  {
+    fprintf(stderr, "Truncated dump: %d records expected.\n", (int)count);
+    return 1;
+  }
+
+  printf("%d records, %d overwritten, times in %s\n", (int)count, (int)overwritten, unit);
+  printf("%12s %10s %4s  %-11s %s\n", "time", "delta", "pin", "event", "value");
+  uint32_t previous = 0;
+  for(uint16_t i=0; i<count; i++)
+  {
+    const unsigned char * p = &data[anyrtttl::RTTTL_TRACE_HEADER_SIZE + i * anyrtttl::RTTTL_TRACE_RECORD_SIZE];
+    uint32_t time = readUint16(p) | ((uint32_t)readUint16(p+2) << 16);
+    byte event = p[4];
+    byte pin = p[5];
+    uint16_t value = readUint16(p+6);
+    uint32_t delta = (i > 0 ? time - previous : 0);
+    previous = time;
+    printf("%12lu %+10ld %4d  %-11s %s\n", (unsigned long)time, (long)delta, (int)pin, getEventName(event), getDescription(event, value, unit).c_str());
+  }
+  return 0;
+}
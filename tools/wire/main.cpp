@@ -0,0 +1,336 @@
+// ---------------------------------------------------------------------------
+// AUTHOR/LICENSE:
+//  The following code was written by Antoine Beauchamp. For other authors, see AUTHORS file.
+//  The code & updates for the library can be found at https://github.com/end2endzone/AnyRtttl
+//  MIT License: http://www.opensource.org/licenses/mit-license.php
+// ---------------------------------------------------------------------------
+
+// anyrtttl_wire: Sends RTTTL melodies over a serial port with the wire protocol.
+// Also decodes received frames and runs a loopback test over a pseudo-terminal pair.
+// See rtttl_wire.h for the format of a frame.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "anyrtttl.h"
+#include "binrtttl.h"
+#include "rtttl_wire.h"
+
+static const byte WIRE_PIN = 8; // any pin. No buzzer is connected.
+
+struct tone_event_t
+{
+  unsigned int frequency;
+  unsigned long duration;
+};
+
+// Tones played by the decoder. The decoder runs on a virtual clock.
+static std::vector<tone_event_t> gTones;
+static unsigned long gVirtualMillis = 0;
+
+static void recordTone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+  tone_event_t e = { frequency, duration };
+  gTones.push_back(e);
+}
+
+static void recordNoTone(uint8_t pin)
+{
+}
+
+static unsigned long virtualMillis()
+{
+  return gVirtualMillis;
+}
+
+static void printUsage(const char * iName)
+{
+  printf("Usage: %s [options] <melody>\n", iName);
+  printf("       %s --receive --device <path> [--baud N]\n", iName);
+  printf("       %s --loopback [--bits 10|16] <melody>\n", iName);
+  printf("Sends an RTTTL melody with the wire protocol. See rtttl_wire.h.\n");
+  printf("\n");
+  printf("  --bits N         Number of bits per note. Must be 10 or 16. Default is 10.\n");
+  printf("  --device <path>  Serial port. For example /dev/ttyUSB0. Default is the standard output.\n");
+  printf("  --baud N         Baud rate of the serial port. Default is 115200.\n");
+  printf("  --receive        Decode the frames received from the serial port and print the notes.\n");
+  printf("  --loopback       Send the melody over a pseudo-terminal pair, decode it and\n");
+  printf("                   compare the notes with the RTTTL text melody.\n");
+  printf("  melody           An RTTTL melody. For example: \"tetris:d=4,o=5,b=160:e6,8b,8c6\"\n");
+}
+
+static speed_t getSpeed(long iBaud)
+{
+  switch(iBaud)
+  {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    default:      return B0;
+  };
+}
+
+// Configures a terminal for raw binary transfer.
+static bool setRaw(int iFd, speed_t iSpeed)
+{
+  struct termios tio;
+  if (tcgetattr(iFd, &tio) != 0)
+    return false;
+  cfmakeraw(&tio);
+  tio.c_cflag |= (CLOCAL | CREAD);
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 1; // return from read() after 100 ms without data
+  if (iSpeed != B0)
+  {
+    cfsetispeed(&tio, iSpeed);
+    cfsetospeed(&tio, iSpeed);
+  }
+  return (tcsetattr(iFd, TCSANOW, &tio) == 0);
+}
+
+static bool writeAll(int iFd, const unsigned char * iBuffer, size_t iSize)
+{
+  while (iSize > 0)
+  {
+    ssize_t count = write(iFd, iBuffer, iSize);
+    if (count <= 0)
+      return false;
+    iBuffer += count;
+    iSize -= count;
+  }
+  return true;
+}
+
+// Encodes a melody as frames.
+static bool encodeFrames(const char * iMelody, byte iBitsPerNote, std::vector<unsigned char> & oFrames)
+{
+  std::vector<unsigned char> binary(anyrtttl::encode(iMelody, &anyrtttl::readCharMem, iBitsPerNote, NULL, 0));
+  if (binary.empty() || anyrtttl::encode(iMelody, &anyrtttl::readCharMem, iBitsPerNote, &binary[0], (uint16_t)binary.size()) == 0)
+    return false;
+
+  oFrames.resize(anyrtttl::wire::encode(&binary[0], (uint16_t)binary.size(), iBitsPerNote, NULL, 0));
+  if (oFrames.empty())
+    return false;
+  return (anyrtttl::wire::encode(&binary[0], (uint16_t)binary.size(), iBitsPerNote, &oFrames[0], (uint16_t)oFrames.size()) > 0);
+}
+
+/****************************************************************************
+ * Description:
+ *   Reads frames from a file descriptor and plays the melody on the virtual clock.
+ *   When iWriteFd is valid, iFrames are written to it in small chunks
+ *   while reading, like a slow serial link.
+ ****************************************************************************/
+static bool receive(int iReadFd, int iWriteFd, const std::vector<unsigned char> & iFrames, anyrtttl::rtttl_wire_t & w)
+{
+  anyrtttl::rtttl_stream_t s;
+  anyrtttl::wire::init(w, s);
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::beginStream(c, WIRE_PIN, s);
+
+  static const size_t CHUNK_SIZE = 16;
+  size_t sent = 0;
+  unsigned char buffer[64];
+  size_t length = 0;
+  int idle = 0;
+  while (anyrtttl::nonblocking::isPlaying(c))
+  {
+    if (iWriteFd >= 0 && sent < iFrames.size())
+    {
+      size_t size = (iFrames.size() - sent < CHUNK_SIZE ? iFrames.size() - sent : CHUNK_SIZE);
+      if (!writeAll(iWriteFd, &iFrames[sent], size))
+        return false;
+      sent += size;
+    }
+
+    // read when the decoder has room for more notes
+    if (length < sizeof(buffer) && !anyrtttl::stream::isEnded(s) && anyrtttl::stream::available(s) < anyrtttl::RTTTL_STREAM_QUEUE_SIZE)
+    {
+      ssize_t count = read(iReadFd, buffer + length, sizeof(buffer) - length);
+      if (count > 0)
+      {
+        length += count;
+        idle = 0;
+      }
+      else if (!anyrtttl::stream::isEnded(s) && anyrtttl::stream::available(s) == 0 && ++idle > 50)
+      {
+        fprintf(stderr, "Timeout waiting for frames.\n");
+        return false;
+      }
+    }
+
+    // the decoder stops when the queue is full. Keep the remaining bytes for later.
+    uint16_t consumed = anyrtttl::wire::feed(w, buffer, (uint16_t)length);
+    memmove(buffer, buffer + consumed, length - consumed);
+    length -= consumed;
+
+    anyrtttl::nonblocking::play(c);
+    gVirtualMillis++;
+  }
+  return true;
+}
+
+static int runLoopback(const char * iMelody, byte iBitsPerNote, const std::vector<unsigned char> & iFrames)
+{
+  // the tones of the text melody are the expected result
+  anyrtttl::rtttl_context_t c = {0};
+  anyrtttl::nonblocking::begin(c, WIRE_PIN, iMelody);
+  while (anyrtttl::nonblocking::isPlaying(c))
+  {
+    anyrtttl::nonblocking::play(c);
+    gVirtualMillis++;
+  }
+  std::vector<tone_event_t> expected = gTones;
+  gTones.clear();
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+  {
+    fprintf(stderr, "Unable to create a pseudo-terminal pair.\n");
+    return 1;
+  }
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  if (slave < 0 || !setRaw(slave, B0) || !setRaw(master, B0))
+  {
+    fprintf(stderr, "Unable to open '%s'.\n", ptsname(master));
+    return 1;
+  }
+
+  anyrtttl::rtttl_wire_t w;
+  bool success = receive(slave, master, iFrames, w);
+  close(slave);
+  close(master);
+  if (!success)
+    return 1;
+
+  size_t textSize = strlen(iMelody);
+  printf("notes:   %d\n", (int)gTones.size());
+  printf("text:    %d bytes\n", (int)textSize);
+  printf("frames:  %d bytes, %d bits per note (%.1fx smaller)\n", (int)iFrames.size(), (int)iBitsPerNote, (double)textSize / iFrames.size());
+  printf("errors:  %d\n", (int)w.errors);
+
+  bool identical = (expected.size() == gTones.size());
+  for(size_t i=0; identical && i<expected.size(); i++)
+  {
+    identical = (expected[i].frequency == gTones[i].frequency && expected[i].duration == gTones[i].duration);
+  }
+  printf("result:  %s\n", (identical ? "identical" : "DIFFERENT"));
+  return (identical && w.errors == 0 ? 0 : 1);
+}
+
+int main(int argc, char * argv[])
+{
+  byte bits = 10;
+  const char * device = NULL;
+  long baud = 115200;
+  bool receiveMode = false;
+  bool loopbackMode = false;
+  const char * melody = NULL;
+
+  for(int i=1; i<argc; i++)
+  {
+    std::string arg = argv[i];
+    bool has_value = (i+1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--bits" && has_value)
+      bits = (byte)atoi(argv[++i]);
+    else if (arg == "--device" && has_value)
+      device = argv[++i];
+    else if (arg == "--baud" && has_value)
+      baud = atol(argv[++i]);
+    else if (arg == "--receive")
+      receiveMode = true;
+    else if (arg == "--loopback")
+      loopbackMode = true;
+    else
+      melody = argv[i];
+  }
+
+  if (bits != 10 && bits != 16)
+  {
+    fprintf(stderr, "Invalid number of bits per note: %d. Must be 10 or 16.\n", (int)bits);
+    return 1;
+  }
+  speed_t speed = getSpeed(baud);
+  if (speed == B0)
+  {
+    fprintf(stderr, "Unsupported baud rate: %ld.\n", baud);
+    return 1;
+  }
+  if ((receiveMode && device == NULL) || (!receiveMode && melody == NULL))
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  anyrtttl::setToneFunction(&recordTone);
+  anyrtttl::setNoToneFunction(&recordNoTone);
+  anyrtttl::setMillisFunction(&virtualMillis);
+
+  if (receiveMode)
+  {
+    int fd = open(device, O_RDONLY | O_NOCTTY);
+    if (fd < 0 || !setRaw(fd, speed))
+    {
+      fprintf(stderr, "Unable to open '%s'.\n", device);
+      return 1;
+    }
+    anyrtttl::rtttl_wire_t w;
+    std::vector<unsigned char> none;
+    bool success = receive(fd, -1, none, w);
+    close(fd);
+    for(size_t i=0; i<gTones.size(); i++)
+    {
+      printf("tone(%u, %lu)\n", gTones[i].frequency, gTones[i].duration);
+    }
+    printf("errors: %d\n", (int)w.errors);
+    return (success ? 0 : 1);
+  }
+
+  std::vector<unsigned char> frames;
+  if (!encodeFrames(melody, bits, frames))
+  {
+    fprintf(stderr, "Unable to encode melody '%s'.\n", melody);
+    return 1;
+  }
+
+  if (loopbackMode)
+    return runLoopback(melody, bits, frames);
+
+  int fd = STDOUT_FILENO;
+  if (device != NULL)
+  {
+    fd = open(device, O_WRONLY | O_NOCTTY);
+    if (fd < 0 || !setRaw(fd, speed))
+    {
+      fprintf(stderr, "Unable to open '%s'.\n", device);
+      return 1;
+    }
+  }
+  bool success = writeAll(fd, &frames[0], frames.size());
+  if (device != NULL)
+  {
+    tcdrain(fd);
+    close(fd);
+  }
+  if (!success)
+  {
+    fprintf(stderr, "Unable to write frames.\n");
+    return 1;
+  }
+  fprintf(stderr, "Sent %d bytes (%d bytes as RTTTL text).\n", (int)frames.size(), (int)strlen(melody));
+  return 0;
+}